@@ -0,0 +1,53 @@
+#!/usr/bin/env python3
+"""Compare two ape_bench_scenarios JSON files.
+
+    python3 bench/compare.py baseline.json candidate.json [--threshold 0.10] [--metric ns_per_step]
+
+Prints one row per (scenario, bodies) present in both files and exits with 1
+when the candidate is slower than the baseline by more than the threshold on
+any of them.
+"""
+import argparse
+import json
+import sys
+
+
+def load(path):
+    with open(path) as f:
+        data = json.load(f)
+    return data, {(r["scenario"], r["bodies"]): r for r in data["results"]}
+
+
+def main():
+    ap = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    ap.add_argument("baseline")
+    ap.add_argument("candidate")
+    ap.add_argument("--threshold", type=float, default=0.10, help="allowed relative slowdown (default 0.10)")
+    ap.add_argument("--metric", default="ns_per_step", choices=["ns_per_step", "p50_ns", "p99_ns", "max_ns"])
+    args = ap.parse_args()
+
+    base_doc, base = load(args.baseline)
+    cand_doc, cand = load(args.candidate)
+    if base_doc.get("config") != cand_doc.get("config"):
+        print(f"note: configs differ: {base_doc.get('config')} vs {cand_doc.get('config')}")
+
+    regressions = 0
+    print(f"{'scenario':16} {'bodies':>8} {'baseline':>12} {'candidate':>12} {'change':>8}  pairs/contacts")
+    for key in sorted(base.keys() & cand.keys()):
+        b, c = base[key][args.metric], cand[key][args.metric]
+        change = (c - b) / b if b > 0 else 0.0
+        flag = ""
+        if change > args.threshold:
+            flag = "  REGRESSION"
+            regressions += 1
+        # Different pair/contact counts mean the two builds simulated different scenes
+        same = (base[key]["pairs_per_step"], base[key]["contacts_per_step"]) == \
+               (cand[key]["pairs_per_step"], cand[key]["contacts_per_step"])
+        print(f"{key[0]:16} {key[1]:>8} {b:>12.0f} {c:>12.0f} {change:>+7.1%}  {'same' if same else 'differ'}{flag}")
+    for key in sorted(base.keys() ^ cand.keys()):
+        print(f"{key[0]:16} {key[1]:>8}  only in {'baseline' if key in base else 'candidate'}")
+    return 1 if regressions else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
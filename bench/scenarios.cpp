@@ -0,0 +1,311 @@
+// Scenario benchmark: steps named workloads at given body counts and reports
+// per-step latency (mean, p50, p99, max) plus pairs/contacts per step, as a
+// table on stdout and optionally as JSON for bench/compare.py.
+//
+//   ape_bench_scenarios [--scenario NAME[,NAME...]|all] [--bodies N[,N...]]
+//                       [--steps S] [--warmup W] [--threads T]
+//                       [--broadphase sap|tree|grid|regions] [--solver sequential|colored|simd]
+//                       [--json PATH]
+#include "ape/ape.h"
+#include "ape/version.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ape;
+
+namespace {
+
+constexpr float dt = 1.0f / 60.0f;
+
+// Static floor box (mass 0): never moves and costs nothing against itself
+std::uint32_t add_floor(World& w, Vec3 center, Vec3 half) {
+    RigidBodyDesc d{};
+    d.mass = 0.0f;
+    d.shape_type = ShapeType::Box;
+    d.box_half_extents = half;
+    d.position = center;
+    return w.createRigidBody(d);
+}
+
+// Side of the smallest square holding n items
+int square_side(std::size_t n) { return std::max(1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(n))))); }
+
+// Spheres scattered through a volume sized for ~1 body per 64 m^3, falling freely
+void build_free_fall(World& w, std::size_t n, std::mt19937& rng) {
+    const float side = std::cbrt(64.0f * static_cast<float>(n));
+    std::uniform_real_distribution<float> u(0.0f, side);
+    std::vector<RigidBodyDesc> descs(n);
+    for (RigidBodyDesc& d : descs) d.position = {u(rng), u(rng), u(rng)};
+    std::vector<std::uint32_t> ids(n);
+    w.createRigidBodies(descs, ids);
+}
+
+// Spheres packed in a grid of touching columns on a floor: settles into a resting pile
+void build_pile(World& w, std::size_t n, std::mt19937& rng) {
+    const int side = square_side(n / 16 + 1); // ~16 layers
+    const float extent = static_cast<float>(side);
+    add_floor(w, {extent * 0.5f, -0.5f, extent * 0.5f}, {extent * 0.5f + 1.0f, 0.5f, extent * 0.5f + 1.0f});
+    std::uniform_real_distribution<float> jitter(-0.02f, 0.02f);
+    std::vector<RigidBodyDesc> descs(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const int x = static_cast<int>(i) % side, z = (static_cast<int>(i) / side) % side, y = static_cast<int>(i) / (side * side);
+        descs[i].position = {static_cast<float>(x) + 0.5f + jitter(rng), 0.5f + static_cast<float>(y), static_cast<float>(z) + 0.5f + jitter(rng)};
+    }
+    std::vector<std::uint32_t> ids(n);
+    w.createRigidBodies(descs, ids);
+}
+
+// Stacks of 10 unit boxes, 2 m apart, on a floor
+void build_box_stacks(World& w, std::size_t n, std::mt19937&) {
+    constexpr int height = 10;
+    const int side = square_side((n + height - 1) / height);
+    const float extent = 2.0f * static_cast<float>(side);
+    add_floor(w, {extent * 0.5f, -0.5f, extent * 0.5f}, {extent * 0.5f + 1.0f, 0.5f, extent * 0.5f + 1.0f});
+    std::vector<RigidBodyDesc> descs(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        const int stack = static_cast<int>(i) / height, level = static_cast<int>(i) % height;
+        descs[i].shape_type = ShapeType::Box;
+        descs[i].box_half_extents = {0.5f, 0.5f, 0.5f};
+        descs[i].position = {2.0f * static_cast<float>(stack % side) + 1.0f, 0.5f + static_cast<float>(level),
+                             2.0f * static_cast<float>(stack / side) + 1.0f};
+    }
+    std::vector<std::uint32_t> ids(n);
+    w.createRigidBodies(descs, ids);
+}
+
+// Spheres spread through a tall column above a box floor: they arrive over
+// time, so contacts grow during the run
+void build_rain(World& w, std::size_t n, std::mt19937& rng) {
+    const float side = 2.0f * static_cast<float>(square_side(n / 8 + 1));
+    add_floor(w, {side * 0.5f, -0.5f, side * 0.5f}, {side * 0.5f + 1.0f, 0.5f, side * 0.5f + 1.0f});
+    std::uniform_real_distribution<float> u(0.0f, side);
+    std::uniform_real_distribution<float> h(2.0f, 2.0f + 0.05f * static_cast<float>(n));
+    std::vector<RigidBodyDesc> descs(n);
+    for (RigidBodyDesc& d : descs) {
+        d.position = {u(rng), h(rng), u(rng)};
+        d.sphere_radius = 0.25f;
+        d.restitution = 0.3f;
+    }
+    std::vector<std::uint32_t> ids(n);
+    w.createRigidBodies(descs, ids);
+}
+
+// Zero gravity grid of separated spheres; 2% keep drifting, the rest fall
+// asleep during warm-up
+void build_sleeping_field(World& w, std::size_t n, std::mt19937& rng) {
+    w.setGravity({0, 0, 0});
+    const int side = square_side(n);
+    std::uniform_real_distribution<float> v(-1.0f, 1.0f);
+    std::uniform_int_distribution<int> pick(0, 49);
+    std::vector<RigidBodyDesc> descs(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        descs[i].position = {1.5f * static_cast<float>(static_cast<int>(i) % side), 0.0f,
+                             1.5f * static_cast<float>(static_cast<int>(i) / side)};
+        if (pick(rng) == 0) descs[i].velocity = {v(rng), 0.0f, v(rng)};
+    }
+    std::vector<std::uint32_t> ids(n);
+    w.createRigidBodies(descs, ids);
+}
+
+struct Scenario {
+    const char* name;
+    void (*build)(World&, std::size_t, std::mt19937&);
+};
+
+constexpr Scenario scenarios[] = {
+    {"free_fall", build_free_fall},
+    {"pile", build_pile},
+    {"box_stacks", build_box_stacks},
+    {"rain", build_rain},
+    {"sleeping_field", build_sleeping_field},
+};
+
+struct Options {
+    std::vector<std::string> names;
+    std::vector<std::size_t> bodies{1000, 10000};
+    int steps{300};
+    int warmup{60};
+    unsigned threads{1};
+    BroadphaseType broadphase{BroadphaseType::SweepAndPrune};
+    SolverType solver{SolverType::Sequential};
+    const char* json{nullptr};
+};
+
+struct Result {
+    std::string scenario;
+    std::size_t bodies;
+    double mean_ns, p50_ns, p99_ns, max_ns;
+    double pairs, contacts, awake;
+};
+
+Result run(const Scenario& sc, std::size_t n, const Options& opt) {
+    World w(WorldDesc{n + 16 >= 65535 ? 20u : 16u}); // room for the floor bodies
+    w.setThreadCount(opt.threads);
+    w.setBroadphase(opt.broadphase);
+    w.setSolver(opt.solver);
+    std::mt19937 rng(12345); // fixed seed: every run of a scenario is the same scene
+    sc.build(w, n, rng);
+    for (int i = 0; i < opt.warmup; ++i) w.step(dt);
+
+    std::vector<double> ns(static_cast<std::size_t>(opt.steps));
+    double pairs = 0, contacts = 0, awake = 0;
+    for (int i = 0; i < opt.steps; ++i) {
+        const auto t0 = std::chrono::steady_clock::now();
+        w.step(dt);
+        const auto t1 = std::chrono::steady_clock::now();
+        ns[static_cast<std::size_t>(i)] = std::chrono::duration<double, std::nano>(t1 - t0).count();
+        pairs += w.debug_broadphasePairCount();
+        contacts += w.stepStats().contacts;
+        awake += w.stepStats().awake_bodies;
+    }
+    Result r{sc.name, n, 0, 0, 0, 0, 0, 0, 0};
+    const double steps = static_cast<double>(std::max(opt.steps, 1));
+    for (double v : ns) r.mean_ns += v;
+    r.mean_ns /= steps;
+    std::sort(ns.begin(), ns.end());
+    const auto pct = [&](double p) {
+        if (ns.empty()) return 0.0;
+        const auto k = static_cast<std::size_t>(std::ceil(p * static_cast<double>(ns.size())));
+        return ns[std::min(ns.size() - 1, k > 0 ? k - 1 : 0)];
+    };
+    r.p50_ns = pct(0.50);
+    r.p99_ns = pct(0.99);
+    r.max_ns = ns.empty() ? 0.0 : ns.back();
+    r.pairs = pairs / steps;
+    r.contacts = contacts / steps;
+    r.awake = awake / steps;
+    return r;
+}
+
+std::vector<std::string> split(const char* s) {
+    std::vector<std::string> out;
+    std::string cur;
+    for (; *s; ++s) {
+        if (*s == ',') { if (!cur.empty()) out.push_back(cur); cur.clear(); }
+        else cur += *s;
+    }
+    if (!cur.empty()) out.push_back(cur);
+    return out;
+}
+
+[[noreturn]] void usage(const char* msg) {
+    std::fprintf(stderr, "ape_bench_scenarios: %s\n", msg);
+    std::fprintf(stderr, "usage: ape_bench_scenarios [--scenario NAME[,NAME...]|all] [--bodies N[,N...]] [--steps S]\n"
+                         "       [--warmup W] [--threads T] [--broadphase sap|tree|grid|regions]\n"
+                         "       [--solver sequential|colored|simd] [--json PATH]\nscenarios:");
+    for (const Scenario& sc : scenarios) std::fprintf(stderr, " %s", sc.name);
+    std::fprintf(stderr, "\n");
+    std::exit(2);
+}
+
+Options parse(int argc, char** argv) {
+    Options opt;
+    for (int i = 1; i < argc; ++i) {
+        const char* a = argv[i];
+        if (i + 1 >= argc) usage("missing value");
+        const char* v = argv[++i];
+        if (!std::strcmp(a, "--scenario")) {
+            if (std::strcmp(v, "all") != 0) opt.names = split(v);
+        } else if (!std::strcmp(a, "--bodies")) {
+            opt.bodies.clear();
+            for (const std::string& s : split(v)) opt.bodies.push_back(static_cast<std::size_t>(std::strtoull(s.c_str(), nullptr, 10)));
+        } else if (!std::strcmp(a, "--steps")) {
+            opt.steps = std::atoi(v);
+        } else if (!std::strcmp(a, "--warmup")) {
+            opt.warmup = std::atoi(v);
+        } else if (!std::strcmp(a, "--threads")) {
+            opt.threads = static_cast<unsigned>(std::atoi(v));
+        } else if (!std::strcmp(a, "--broadphase")) {
+            if (!std::strcmp(v, "sap")) opt.broadphase = BroadphaseType::SweepAndPrune;
+            else if (!std::strcmp(v, "tree")) opt.broadphase = BroadphaseType::DynamicTree;
+            else if (!std::strcmp(v, "grid")) opt.broadphase = BroadphaseType::SpatialGrid;
+            else if (!std::strcmp(v, "regions")) opt.broadphase = BroadphaseType::Regions;
+            else usage("unknown broadphase");
+        } else if (!std::strcmp(a, "--solver")) {
+            if (!std::strcmp(v, "sequential")) opt.solver = SolverType::Sequential;
+            else if (!std::strcmp(v, "colored")) opt.solver = SolverType::GraphColored;
+            else if (!std::strcmp(v, "simd")) opt.solver = SolverType::Simd;
+            else usage("unknown solver");
+        } else if (!std::strcmp(a, "--json")) {
+            opt.json = v;
+        } else {
+            usage("unknown option");
+        }
+    }
+    if (opt.steps <= 0 || opt.warmup < 0 || opt.bodies.empty()) usage("invalid counts");
+    for (const std::string& name : opt.names) {
+        const bool known = std::any_of(std::begin(scenarios), std::end(scenarios),
+                                       [&](const Scenario& sc) { return name == sc.name; });
+        if (!known) usage("unknown scenario");
+    }
+    return opt;
+}
+
+const char* broadphase_name(BroadphaseType t) {
+    switch (t) {
+    case BroadphaseType::DynamicTree: return "tree";
+    case BroadphaseType::SpatialGrid: return "grid";
+    case BroadphaseType::Regions: return "regions";
+    default: return "sap";
+    }
+}
+
+const char* solver_name(SolverType t) {
+    switch (t) {
+    case SolverType::GraphColored: return "colored";
+    case SolverType::Simd: return "simd";
+    default: return "sequential";
+    }
+}
+
+bool write_json(const char* path, const Options& opt, const std::vector<Result>& results) {
+    std::FILE* f = std::fopen(path, "w");
+    if (!f) return false;
+    std::fprintf(f, "{\n  \"engine\": \"%d.%d.%d\",\n", APE_VERSION_MAJOR, APE_VERSION_MINOR, APE_VERSION_PATCH);
+    std::fprintf(f, "  \"config\": {\"steps\": %d, \"warmup\": %d, \"threads\": %u, \"broadphase\": \"%s\", \"solver\": \"%s\", "
+                    "\"dt\": %.9g, \"stats\": %s},\n",
+                 opt.steps, opt.warmup, opt.threads, broadphase_name(opt.broadphase), solver_name(opt.solver),
+                 static_cast<double>(dt), World::statsEnabled() ? "true" : "false");
+    std::fprintf(f, "  \"results\": [\n");
+    for (std::size_t i = 0; i < results.size(); ++i) {
+        const Result& r = results[i];
+        std::fprintf(f, "    {\"scenario\": \"%s\", \"bodies\": %zu, \"ns_per_step\": %.0f, \"p50_ns\": %.0f, \"p99_ns\": %.0f, "
+                        "\"max_ns\": %.0f, \"pairs_per_step\": %.1f, \"contacts_per_step\": %.1f, \"awake_per_step\": %.1f}%s\n",
+                     r.scenario.c_str(), r.bodies, r.mean_ns, r.p50_ns, r.p99_ns, r.max_ns, r.pairs, r.contacts, r.awake,
+                     i + 1 < results.size() ? "," : "");
+    }
+    std::fprintf(f, "  ]\n}\n");
+    return std::fclose(f) == 0;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const Options opt = parse(argc, argv);
+    std::vector<Result> results;
+    std::printf("%-16s %8s %12s %12s %12s %12s %10s %10s\n", "scenario", "bodies", "ns/step", "p50_ns", "p99_ns",
+                "max_ns", "pairs", "contacts");
+    for (const Scenario& sc : scenarios) {
+        if (!opt.names.empty() && std::find(opt.names.begin(), opt.names.end(), sc.name) == opt.names.end()) continue;
+        for (std::size_t n : opt.bodies) {
+            const Result r = run(sc, n, opt);
+            std::printf("%-16s %8zu %12.0f %12.0f %12.0f %12.0f %10.1f %10.1f\n", r.scenario.c_str(), r.bodies,
+                        r.mean_ns, r.p50_ns, r.p99_ns, r.max_ns, r.pairs, r.contacts);
+            std::fflush(stdout);
+            results.push_back(r);
+        }
+    }
+    if (opt.json && !write_json(opt.json, opt, results)) {
+        std::fprintf(stderr, "ape_bench_scenarios: cannot write %s\n", opt.json);
+        return 1;
+    }
+    return 0;
+}
@@ -2,9 +2,10 @@ import ctypes
 import os
 import sys
 
-# crude loader: prefer local build tree
+# crude loader: APE_LIB overrides, else prefer local build tree
 root = os.path.abspath(os.path.join(__file__, "../../.."))
 lib_candidates = [
+    os.environ.get("APE_LIB", ""),
     os.path.join(root, "build", "libape_c.so"),
     os.path.join(root, "build", "ape_c.dll"),
     os.path.join(root, "build", "libape_c.dylib"),
@@ -12,7 +13,7 @@ lib_candidates = [
 
 _lib = None
 for p in lib_candidates:
-    if os.path.exists(p):
+    if p and os.path.exists(p):
         _lib = ctypes.CDLL(p)
         break
 if _lib is None:
@@ -22,7 +23,7 @@ class Vec3(ctypes.Structure):
     _fields_ = [("x", ctypes.c_float), ("y", ctypes.c_float), ("z", ctypes.c_float)]
 
 class RigidBodyDesc(ctypes.Structure):
-    _fields_ = [("position", Vec3), ("velocity", Vec3), ("mass", ctypes.c_float)]
+    _fields_ = [("position", Vec3), ("velocity", Vec3), ("mass", ctypes.c_float), ("radius", ctypes.c_float)]
 
 _lib.ape_version_major.restype = ctypes.c_uint
 _lib.ape_version_minor.restype = ctypes.c_uint
@@ -46,7 +47,7 @@ def version():
 
 def smoke():
     w = _lib.ape_world_create()
-    d = RigidBodyDesc(position=Vec3(0, 5, 0), velocity=Vec3(0, 0, 0), mass=1.0)
+    d = RigidBodyDesc(position=Vec3(0, 5, 0), velocity=Vec3(0, 0, 0), mass=1.0, radius=0.5)
     rid = _lib.ape_world_create_rigidbody(w, d)
     for _ in range(60):
         _lib.ape_world_step(w, ctypes.c_float(1.0/60.0))
@@ -1,10 +1,56 @@
 #include "ape/ape_c.h"
 #include "ape/ape.h"
+#include "ape/scene_file.h"
 #include "ape/version.h"
 #include <cstdlib>
+#include <vector>
 
 struct ape_world { ape::World* w; };
 
+// Views hand out World storage as ape_vec3 arrays
+static_assert(sizeof(ape_vec3) == sizeof(ape::Vec3) && alignof(ape_vec3) == alignof(ape::Vec3));
+// Mirrored by the bindings (ape_numpy.DESC_DTYPE, engine.js DESC_WORDS)
+static_assert(sizeof(ape_rigidbody_desc_ex) == 64);
+
+static ape::RigidBodyDesc to_desc(const ape_rigidbody_desc& desc) {
+    ape::RigidBodyDesc d;
+    d.position = {desc.position.x, desc.position.y, desc.position.z};
+    d.velocity = {desc.velocity.x, desc.velocity.y, desc.velocity.z};
+    d.mass = desc.mass;
+    d.shape_type = ape::ShapeType::Sphere;
+    d.sphere_radius = desc.radius > 0.0f ? desc.radius : 0.5f;
+    return d;
+}
+
+static ape::RigidBodyDesc to_desc(const ape_rigidbody_desc_ex& desc) {
+    ape::RigidBodyDesc d;
+    d.position = {desc.position.x, desc.position.y, desc.position.z};
+    d.velocity = {desc.velocity.x, desc.velocity.y, desc.velocity.z};
+    d.mass = desc.mass;
+    d.shape_type = desc.shape == 1u ? ape::ShapeType::Box : ape::ShapeType::Sphere;
+    d.sphere_radius = desc.radius > 0.0f ? desc.radius : 0.5f;
+    d.box_half_extents = {desc.half_extents.x, desc.half_extents.y, desc.half_extents.z};
+    d.friction = desc.friction;
+    d.restitution = desc.restitution;
+    if (desc.collision_category != 0u) d.collision_category = desc.collision_category;
+    if (desc.collision_mask != 0u) d.collision_mask = desc.collision_mask;
+    return d;
+}
+
+template <class Desc>
+static size_t create_bodies(ape_world* h, const Desc* descs, size_t count, uint32_t* out_ids) {
+    if (!h || !h->w || !descs || !out_ids) return 0;
+    std::vector<ape::RigidBodyDesc> d(count);
+    for (size_t i = 0; i < count; ++i) d[i] = to_desc(descs[i]);
+    return h->w->createRigidBodies(d, std::span<uint32_t>(out_ids, count));
+}
+
+template <class T>
+static const T* view_ptr(std::span<const T> v, size_t* count) {
+    if (count) *count = v.size();
+    return v.data();
+}
+
 extern "C" {
 
 uint32_t ape_version_major(void) { return APE_VERSION_MAJOR; }
@@ -17,6 +63,14 @@ ape_world* ape_world_create(void) {
     return h;
 }
 
+ape_world* ape_world_create_ex(const ape_world_desc* desc) {
+    ape::WorldDesc d;
+    if (desc && desc->index_bits != 0) d.index_bits = desc->index_bits;
+    ape_world* h = static_cast<ape_world*>(std::malloc(sizeof(ape_world)));
+    h->w = new ape::World(d);
+    return h;
+}
+
 void ape_world_destroy(ape_world* h) {
     if (!h) return;
     delete h->w;
@@ -25,13 +79,7 @@ void ape_world_destroy(ape_world* h) {
 
 uint32_t ape_world_create_rigidbody(ape_world* h, ape_rigidbody_desc desc) {
     if (!h || !h->w) return UINT32_MAX;
-    ape::RigidBodyDesc d;
-    d.position = {desc.position.x, desc.position.y, desc.position.z};
-    d.velocity = {desc.velocity.x, desc.velocity.y, desc.velocity.z};
-    d.mass = desc.mass;
-    d.shape_type = ape::ShapeType::Sphere;
-    d.sphere_radius = desc.radius > 0.0f ? desc.radius : 0.5f;
-    return h->w->createRigidBody(d);
+    return h->w->createRigidBody(to_desc(desc));
 }
 
 void ape_world_destroy_rigidbody(ape_world* h, uint32_t id) {
@@ -41,17 +89,52 @@ void ape_world_destroy_rigidbody(ape_world* h, uint32_t id) {
 
 uint32_t ape_world_create_rigidbody_p(ape_world* h, const ape_rigidbody_desc* desc) {
     if (!h || !h->w || !desc) return UINT32_MAX;
-    ape::RigidBodyDesc d;
-    d.position = {desc->position.x, desc->position.y, desc->position.z};
-    d.velocity = {desc->velocity.x, desc->velocity.y, desc->velocity.z};
-    d.mass = desc->mass;
-    d.shape_type = ape::ShapeType::Sphere;
-    d.sphere_radius = desc->radius > 0.0f ? desc->radius : 0.5f;
-    return h->w->createRigidBody(d);
+    return h->w->createRigidBody(to_desc(*desc));
+}
+
+size_t ape_world_create_rigidbodies(ape_world* h, const ape_rigidbody_desc* descs, size_t count, uint32_t* out_ids) {
+    return create_bodies(h, descs, count, out_ids);
+}
+
+size_t ape_world_create_rigidbodies_ex(ape_world* h, const ape_rigidbody_desc_ex* descs, size_t count, uint32_t* out_ids) {
+    return create_bodies(h, descs, count, out_ids);
+}
+
+void ape_world_destroy_rigidbodies(ape_world* h, const uint32_t* ids, size_t count) {
+    if (!h || !h->w || !ids) return;
+    h->w->destroyRigidBodies(std::span<const uint32_t>(ids, count));
+}
+
+void ape_world_reserve(ape_world* h, size_t capacity) {
+    if (h && h->w) h->w->reserve(capacity);
 }
 
 void ape_world_step(ape_world* h, float dt) { if(h && h->w) h->w->step(dt); }
 
+void ape_world_set_thread_count(ape_world* h, uint32_t threads) {
+    if (h && h->w) h->w->setThreadCount(threads);
+}
+
+void ape_world_step_n(ape_world* h, float dt, uint32_t steps) {
+    if (!h || !h->w) return;
+    for (uint32_t i = 0; i < steps; ++i) h->w->step(dt);
+}
+
+void ape_world_set_positions(ape_world* h, const uint32_t* ids, const ape_vec3* positions, size_t count) {
+    if (!h || !h->w || !ids || !positions) return;
+    for (size_t i = 0; i < count; ++i) h->w->setPosition(ids[i], {positions[i].x, positions[i].y, positions[i].z});
+}
+
+void ape_world_set_velocities(ape_world* h, const uint32_t* ids, const ape_vec3* velocities, size_t count) {
+    if (!h || !h->w || !ids || !velocities) return;
+    for (size_t i = 0; i < count; ++i) h->w->setVelocity(ids[i], {velocities[i].x, velocities[i].y, velocities[i].z});
+}
+
+void ape_world_set_collision_filter(ape_world* h, uint32_t id, uint32_t category, uint32_t mask) {
+    if (!h || !h->w) return;
+    h->w->setCollisionFilter(id, category, mask);
+}
+
 ape_vec3 ape_world_get_position(const ape_world* h, uint32_t id) {
     if (!h || !h->w) return ape_vec3{0,0,0};
     auto p = h->w->getPosition(id);
@@ -109,9 +192,122 @@ uint32_t ape_world_is_alive(const ape_world* h, uint32_t id) {
     return h->w->isAlive(id) ? 1u : 0u;
 }
 
+uint32_t ape_world_is_static(const ape_world* h, uint32_t id) {
+    if (!h || !h->w) return 0u;
+    return h->w->isStatic(id) ? 1u : 0u;
+}
+
 size_t ape_world_body_count(const ape_world* h) {
     if (!h || !h->w) return 0;
     return h->w->bodyCount();
 }
 
+const ape_vec3* ape_world_get_positions_ptr(const ape_world* h, size_t* count) {
+    if (!h || !h->w) { if (count) *count = 0; return nullptr; }
+    return reinterpret_cast<const ape_vec3*>(view_ptr(h->w->bodies().positions, count));
+}
+
+const ape_vec3* ape_world_get_velocities_ptr(const ape_world* h, size_t* count) {
+    if (!h || !h->w) { if (count) *count = 0; return nullptr; }
+    return reinterpret_cast<const ape_vec3*>(view_ptr(h->w->bodies().velocities, count));
+}
+
+const uint8_t* ape_world_get_alive_ptr(const ape_world* h, size_t* count) {
+    if (!h || !h->w) { if (count) *count = 0; return nullptr; }
+    return view_ptr(h->w->bodies().alive, count);
+}
+
+const uint8_t* ape_world_get_awake_ptr(const ape_world* h, size_t* count) {
+    if (!h || !h->w) { if (count) *count = 0; return nullptr; }
+    return view_ptr(h->w->bodies().awake, count);
+}
+
+const uint32_t* ape_world_get_live_slots_ptr(const ape_world* h, size_t* count) {
+    if (!h || !h->w) { if (count) *count = 0; return nullptr; }
+    return view_ptr(h->w->bodies().live_slots, count);
+}
+
+uint32_t ape_world_slot_of(const ape_world* h, uint32_t id) {
+    if (!h || !h->w) return UINT32_MAX;
+    return h->w->slotOf(id);
+}
+
+void ape_world_slots_of(const ape_world* h, const uint32_t* ids, size_t count, uint32_t* out_slots) {
+    if (!ids || !out_slots) return;
+    for (size_t i = 0; i < count; ++i) out_slots[i] = (h && h->w) ? h->w->slotOf(ids[i]) : UINT32_MAX;
+}
+
+uint32_t ape_world_handle_at(const ape_world* h, uint32_t slot) {
+    if (!h || !h->w) return UINT32_MAX;
+    return h->w->handleAt(slot);
+}
+
+size_t ape_world_max_bodies(const ape_world* h) {
+    if (!h || !h->w) return 0;
+    return h->w->maxBodies();
+}
+
+size_t ape_world_snapshot_size(const ape_world* h) {
+    if (!h || !h->w) return 0;
+    return h->w->snapshotSize();
+}
+
+size_t ape_world_save_snapshot(const ape_world* h, void* buffer, size_t capacity) {
+    if (!h || !h->w || !buffer) return 0;
+    return h->w->saveSnapshot(std::span<std::byte>(static_cast<std::byte*>(buffer), capacity));
+}
+
+uint32_t ape_world_restore_snapshot(ape_world* h, const void* data, size_t size) {
+    if (!h || !h->w || !data) return 0;
+    return h->w->restoreSnapshot(std::span<const std::byte>(static_cast<const std::byte*>(data), size)) ? 1u : 0u;
+}
+
+uint32_t ape_world_save_scene(const ape_world* h, const char* path) {
+    if (!h || !h->w) return 0;
+    return ape::saveScene(*h->w, path) ? 1u : 0u;
+}
+
+uint32_t ape_world_load_scene(ape_world* h, const char* path) {
+    if (!h || !h->w) return 0;
+    return ape::loadScene(*h->w, path) ? 1u : 0u;
+}
+
+ape_world* ape_world_create_from_scene(const char* path) {
+    ape::SceneInfo info;
+    if (!ape::readSceneInfo(path, info)) return nullptr;
+    ape_world_desc desc{info.index_bits};
+    ape_world* h = ape_world_create_ex(&desc);
+    if (h && !ape_world_load_scene(h, path)) {
+        ape_world_destroy(h);
+        return nullptr;
+    }
+    return h;
+}
+
+uint32_t ape_world_get_step_stats(const ape_world* h, ape_step_stats* out) {
+    if (!out) return 0;
+    *out = ape_step_stats{};
+    if (!h || !h->w || !ape::World::statsEnabled()) return 0;
+    const ape::StepStats& s = h->w->stepStats();
+    out->total_ms = s.total_ms;
+    out->integrate_ms = s.integrate_ms;
+    out->broadphase_ms = s.broadphase_ms;
+    out->narrowphase_ms = s.narrowphase_ms;
+    out->islands_ms = s.islands_ms;
+    out->solver_ms = s.solver_ms;
+    out->sleep_ms = s.sleep_ms;
+    out->bodies = s.bodies;
+    out->awake_bodies = s.awake_bodies;
+    out->pairs = s.pairs;
+    out->contacts = s.contacts;
+    out->islands = s.islands;
+    out->solved_islands = s.solved_islands;
+    out->solver_iterations = s.solver_iterations;
+    out->solver_residual = s.solver_residual;
+    out->warm_start_hits = s.warm_start_hits;
+    out->warm_start_hit_rate = s.warm_start_hit_rate;
+    out->buffer_growth_bytes = s.buffer_growth_bytes;
+    return 1;
+}
+
 } // extern "C"
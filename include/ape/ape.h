@@ -4,9 +4,13 @@
 #include <cstdint>
 #include <array>
 #include <cstddef>
+#include <span>
+#include <vector>
 
 namespace ape {
 
+class JobSystem;
+
 struct Vec3 {
     float x, y, z;
 };
@@ -16,9 +20,32 @@ enum class ShapeType : std::uint8_t {
     Box = 1,
 };
 
+// Broadphase backend used by World::step. All backends report the same pairs in
+// the same (a, b) order, so switching backends does not change results.
+enum class BroadphaseType : std::uint8_t {
+    SweepAndPrune = 0, // persistent 1D SAP along X (default)
+    DynamicTree = 1,   // dynamic AABB tree with fat bounds; robust to clustered X ranges
+    SpatialGrid = 2,   // uniform hash grid; O(n) for evenly sized bodies (particles, debris)
+    Regions = 3,       // X/Z grid of regions swept independently, in parallel with a job system;
+                       // for wide worlds
+};
+
+// Contact solver used by World::step.
+enum class SolverType : std::uint8_t {
+    Sequential = 0,   // PGS per island in contact order; islands run in parallel (default)
+    GraphColored = 1, // contacts colored so no batch shares a dynamic body; each batch runs in
+                      // parallel. Deterministic: identical results for any thread count.
+    Simd = 2,         // GraphColored batches packed into SoA rows and solved 8/4 contacts per
+                      // instruction (AVX2/SSE, scalar fallback elsewhere; see APE_SIMD in CMake)
+};
+
 struct RigidBodyDesc {
     Vec3 position{0,0,0};
     Vec3 velocity{0,0,0};
+    // mass <= 0 makes a static body: fixed in place (no gravity, velocity or
+    // sleep), infinite mass in the solver, and kept in its own broadphase tree
+    // that only awake bodies are tested against. Static-static pairs never
+    // cost anything, so floors and walls can be many boxes.
     float mass{1.0f};
     
     // Shape (shape_type determines which shape fields are used)
@@ -29,29 +56,157 @@ struct RigidBodyDesc {
     // Material properties
     float friction{0.5f};    // Coulomb friction coefficient (0=frictionless, 1=high friction)
     float restitution{0.0f}; // Coefficient of restitution (0=inelastic, 1=perfectly elastic)
+
+    // Collision layers: two bodies collide only if each one's category shares
+    // a bit with the other's mask (e.g. debris in category 4 with mask ~4u
+    // never touches other debris). The broadphase drops filtered pairs before
+    // the narrowphase. Default: category 1, colliding with every category.
+    std::uint32_t collision_category{1};
+    std::uint32_t collision_mask{0xFFFFFFFFu};
+};
+
+// Read-only view of the body arrays, indexed by slot (the index part of a
+// handle; see World::slotOf). Points into World storage: valid until the next
+// create/destroy/reserve/step. Free slots (alive[i] == 0) hold stale data.
+struct BodyView {
+    std::span<const Vec3> positions;
+    std::span<const Vec3> velocities;
+    std::span<const std::uint8_t> alive;       // 1 if the slot holds a body
+    std::span<const std::uint8_t> awake;       // 1 if awake, 0 if sleeping, static (or free)
+    std::span<const std::uint32_t> live_slots; // occupied slots, unordered
+};
+
+// Owned buffer for World::saveSnapshot. Saving into the same snapshot again
+// (e.g. a ring of them, one per frame) reuses its memory, so steady-state
+// saves do not allocate.
+struct WorldSnapshot {
+    std::vector<std::byte> bytes;
+};
+
+// Per-step statistics, refreshed by every World::step (see World::stepStats).
+// Collected only when the library is built with APE_ENABLE_STATS (CMake option,
+// default OFF); otherwise the collection code is compiled out and all fields stay 0.
+struct StepStats {
+    // Wall time per stage, milliseconds
+    double total_ms{0};
+    double integrate_ms{0};   // gravity and position integration
+    double broadphase_ms{0};  // AABB refresh and pair update
+    double narrowphase_ms{0};
+    double islands_ms{0};     // island build and wake propagation
+    double solver_ms{0};      // warm start, iterations, positional correction, cache store
+    double sleep_ms{0};
+    // Counters
+    std::uint32_t bodies{0};
+    std::uint32_t awake_bodies{0};   // at the start of the step
+    std::uint32_t pairs{0};          // broadphase candidate pairs
+    std::uint32_t contacts{0};
+    std::uint32_t islands{0};
+    std::uint32_t solved_islands{0}; // awake islands with contacts
+    std::uint32_t solver_iterations{0};
+    float solver_residual{0};        // largest approaching normal velocity (m/s) left after solving
+    std::uint32_t warm_start_hits{0}; // contacts found in the warm-start cache
+    float warm_start_hit_rate{0};    // warm_start_hits / contacts (0 without contacts)
+    // Growth of the World's own step buffers (boxes, pairs, contacts, narrowphase
+    // chunks, frame arena); 0 in steady state. Storage inside the broadphase
+    // backends, island builder and solvers is not included.
+    std::uint64_t buffer_growth_bytes{0};
+};
+
+// World construction options
+struct WorldDesc {
+    // Handle layout: [generation : 32 - index_bits][index : index_bits]. More
+    // index bits allow more bodies (2^index_bits - 1) but fewer generations
+    // before a recycled slot hands out a repeated handle. Clamped to [8, 28].
+    // 16 (default): 65,535 bodies; 20: 1,048,575 bodies with 4,096 generations.
+    std::uint32_t index_bits{16};
 };
 
 class World {
 public:
     World();
+    explicit World(const WorldDesc& desc);
     ~World();
 
     std::uint32_t createRigidBody(const RigidBodyDesc& desc);
     void destroyRigidBody(std::uint32_t id);
+
+    // Bulk variants for spawn bursts. createRigidBodies writes one handle per
+    // desc to out (min of both sizes), taking the same slots as repeated
+    // createRigidBody calls but growing storage once; handles past the index
+    // space are UINT32_MAX. Returns the number of bodies created.
+    std::size_t createRigidBodies(std::span<const RigidBodyDesc> descs, std::span<std::uint32_t> out);
+    void destroyRigidBodies(std::span<const std::uint32_t> ids);
+    // Pre-allocate storage for `capacity` body slots (clamped to maxBodies())
+    void reserve(std::size_t capacity);
     void step(float dt);
     Vec3 getPosition(std::uint32_t id) const;
     Vec3 getVelocity(std::uint32_t id) const;
+    // Teleport / set velocity; wakes a sleeping body. Invalid handles are ignored.
+    // Static bodies can be teleported (their broadphase proxy is moved) but
+    // keep zero velocity.
+    void setPosition(std::uint32_t id, const Vec3& p);
+    void setVelocity(std::uint32_t id, const Vec3& v);
+    // Change a body's collision category/mask (see RigidBodyDesc); takes effect
+    // on the next step and wakes a sleeping body. Invalid handles are ignored.
+    void setCollisionFilter(std::uint32_t id, std::uint32_t category, std::uint32_t mask);
+
+    // Rollback: flat copy of the simulation state (body arrays, collision
+    // filters, generations and free list, sleep state, broadphase boxes,
+    // warm-start cache). Settings (gravity, solver, broadphase, threads) are
+    // not included. Steps taken after restoreSnapshot reproduce the steps
+    // taken after the save bit for bit.
+    std::size_t snapshotSize() const;
+    // Writes into caller memory; returns the bytes written, 0 if out is too small
+    std::size_t saveSnapshot(std::span<std::byte> out) const;
+    void saveSnapshot(WorldSnapshot& out) const;
+    // False (world unchanged) unless `in` is a well-formed snapshot of a world
+    // with the same handle layout (WorldDesc::index_bits)
+    bool restoreSnapshot(std::span<const std::byte> in);
+    bool restoreSnapshot(const WorldSnapshot& in);
 
     // Global gravity (default 0,-9.80665,0)
     void setGravity(const Vec3& g);
     Vec3 getGravity() const;
 
+    // Multithreaded stepping (opt-in). With a JobSystem attached, step() runs its
+    // stages in order and splits each per-body/per-pair stage across workers.
+    // Results are identical to single-threaded stepping.
+    // setJobSystem borrows `jobs` (caller keeps it alive; nullptr = single-threaded).
+    // setThreadCount creates a JobSystem owned by the World (0 or 1 = single-threaded).
+    void setJobSystem(JobSystem* jobs);
+    void setThreadCount(unsigned threads);
+    JobSystem* jobSystem() const;
+
+    // Broadphase backend selection (default SweepAndPrune)
+    void setBroadphase(BroadphaseType type);
+    BroadphaseType broadphase() const;
+
+    // Contact solver selection (default Sequential). GraphColored parallelizes
+    // inside large islands (piles, stacks) at the cost of a different, but fixed,
+    // contact order.
+    void setSolver(SolverType type);
+    SolverType solver() const;
+
     // Temporary debug helper: number of broadphase candidate pairs from last step
     std::uint32_t debug_broadphasePairCount() const;
 
+    // Statistics of the last step (all zero before the first step or when
+    // statsEnabled() is false)
+    const StepStats& stepStats() const;
+    static bool statsEnabled();
+
     // Introspection helpers
     bool isAlive(std::uint32_t id) const;
+    bool isStatic(std::uint32_t id) const; // live body with mass <= 0
     std::size_t bodyCount() const;
+    std::size_t maxBodies() const; // bodies addressable by the handle layout
+
+    // Zero-copy access to body state (see BodyView). slotOf maps a live handle
+    // to its slot and handleAt maps an occupied slot back; both return
+    // UINT32_MAX otherwise.
+    BodyView bodies() const;
+    std::uint32_t slotOf(std::uint32_t id) const;
+    std::uint32_t handleAt(std::uint32_t slot) const;
 
 private:
     struct Impl;
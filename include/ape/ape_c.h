@@ -18,6 +18,23 @@ typedef struct ape_rigidbody_desc {
     float radius;
 } ape_rigidbody_desc;
 
+// Full body description (shape and material); layout is fixed so arrays of it
+// can be filled from other languages (e.g. a NumPy structured array)
+typedef struct ape_rigidbody_desc_ex {
+    ape_vec3 position;
+    ape_vec3 velocity;
+    float mass;
+    uint32_t shape;        // 0 = sphere, 1 = box
+    float radius;          // sphere radius; ignored if <= 0
+    ape_vec3 half_extents; // box half extents
+    float friction;
+    float restitution;
+    // Collision layers (see ape::RigidBodyDesc): 0 takes the default, so a
+    // zeroed desc collides with everything (category 1, mask all bits)
+    uint32_t collision_category;
+    uint32_t collision_mask;
+} ape_rigidbody_desc_ex;
+
 typedef struct ape_world ape_world; // opaque
 
 // Versioning
@@ -25,12 +42,43 @@ uint32_t ape_version_major(void);
 uint32_t ape_version_minor(void);
 uint32_t ape_version_patch(void);
 
+// World creation options (see ape::WorldDesc); zero fields take the defaults
+typedef struct ape_world_desc {
+    // Handle index bits: up to 2^index_bits - 1 bodies, 32 - index_bits
+    // generation bits. Clamped to [8, 28]; 0 = 16.
+    uint32_t index_bits;
+} ape_world_desc;
+
 ape_world* ape_world_create(void);
+ape_world* ape_world_create_ex(const ape_world_desc* desc); // NULL = defaults
 void ape_world_destroy(ape_world* w);
 
 uint32_t ape_world_create_rigidbody(ape_world* w, ape_rigidbody_desc desc);
 void ape_world_destroy_rigidbody(ape_world* w, uint32_t id);
 void ape_world_step(ape_world* w, float dt);
+
+// Bulk creation/destruction for spawn bursts (see World::createRigidBodies).
+// out_ids receives one handle per desc, UINT32_MAX once the index space is
+// full; returns the number of bodies created.
+size_t ape_world_create_rigidbodies(ape_world* w, const ape_rigidbody_desc* descs, size_t count, uint32_t* out_ids);
+void ape_world_destroy_rigidbodies(ape_world* w, const uint32_t* ids, size_t count);
+void ape_world_reserve(ape_world* w, size_t capacity);
+size_t ape_world_create_rigidbodies_ex(ape_world* w, const ape_rigidbody_desc_ex* descs, size_t count, uint32_t* out_ids);
+
+// Worker threads used by step (0 or 1 = single-threaded; see World::setThreadCount).
+// In WebAssembly this needs the threaded build (ape_wasm_mt).
+void ape_world_set_thread_count(ape_world* w, uint32_t threads);
+
+// Run `steps` fixed steps of dt without returning to the caller in between
+void ape_world_step_n(ape_world* w, float dt, uint32_t steps);
+
+// Bulk state writes (positions[i] / velocities[i] for ids[i]); wake the bodies,
+// invalid handles are skipped
+void ape_world_set_positions(ape_world* w, const uint32_t* ids, const ape_vec3* positions, size_t count);
+void ape_world_set_velocities(ape_world* w, const uint32_t* ids, const ape_vec3* velocities, size_t count);
+// Collision category/mask of a live body, taken as given (0 = collides with
+// nothing); wakes it. Invalid handles are ignored.
+void ape_world_set_collision_filter(ape_world* w, uint32_t id, uint32_t category, uint32_t mask);
 ape_vec3 ape_world_get_position(const ape_world* w, uint32_t id);
 ape_vec3 ape_world_get_velocity(const ape_world* w, uint32_t id);
 
@@ -45,9 +93,66 @@ void ape_world_get_velocity_out(const ape_world* w, uint32_t id, ape_vec3* out);
 void ape_world_set_gravity_p(ape_world* w, const ape_vec3* g);
 void ape_world_get_gravity_out(const ape_world* w, ape_vec3* out);
 
+// Zero-copy views of body state, indexed by slot (the index part of a handle).
+// Pointers stay valid until the next create/destroy/reserve/step; *count (if
+// non-NULL) receives the array length. Free slots have alive == 0 and stale
+// data. live_slots lists the occupied slots in no particular order.
+const ape_vec3* ape_world_get_positions_ptr(const ape_world* w, size_t* count);
+const ape_vec3* ape_world_get_velocities_ptr(const ape_world* w, size_t* count);
+const uint8_t* ape_world_get_alive_ptr(const ape_world* w, size_t* count);
+const uint8_t* ape_world_get_awake_ptr(const ape_world* w, size_t* count);
+const uint32_t* ape_world_get_live_slots_ptr(const ape_world* w, size_t* count);
+uint32_t ape_world_slot_of(const ape_world* w, uint32_t id);     // UINT32_MAX if not alive
+uint32_t ape_world_handle_at(const ape_world* w, uint32_t slot); // UINT32_MAX if free
+void ape_world_slots_of(const ape_world* w, const uint32_t* ids, size_t count, uint32_t* out_slots);
+
+// Rollback snapshots (see World::saveSnapshot): save returns the bytes written,
+// 0 if capacity < ape_world_snapshot_size; restore returns 1 on success, 0 (world
+// unchanged) if the data is not a snapshot of a world with the same handle layout.
+size_t ape_world_snapshot_size(const ape_world* w);
+size_t ape_world_save_snapshot(const ape_world* w, void* buffer, size_t capacity);
+uint32_t ape_world_restore_snapshot(ape_world* w, const void* data, size_t size);
+
+// Binary scene files (see ape/scene_file.h): the world state as one mappable
+// file. Save/load return 1 on success, 0 otherwise (load leaves the world
+// unchanged on failure, including a different handle layout).
+// create_from_scene builds a world with the scene's handle layout; NULL on failure.
+uint32_t ape_world_save_scene(const ape_world* w, const char* path);
+uint32_t ape_world_load_scene(ape_world* w, const char* path);
+ape_world* ape_world_create_from_scene(const char* path);
+
+// Statistics of the last step (see ape::StepStats). Fills *out and returns 1
+// when the library was built with APE_ENABLE_STATS; otherwise zeroes *out and
+// returns 0.
+typedef struct ape_step_stats {
+    // Wall time per stage, milliseconds
+    double total_ms;
+    double integrate_ms;
+    double broadphase_ms;
+    double narrowphase_ms;
+    double islands_ms;
+    double solver_ms;
+    double sleep_ms;
+    uint32_t bodies;
+    uint32_t awake_bodies;
+    uint32_t pairs;
+    uint32_t contacts;
+    uint32_t islands;
+    uint32_t solved_islands;
+    uint32_t solver_iterations;
+    float solver_residual;
+    uint32_t warm_start_hits;
+    float warm_start_hit_rate;
+    uint64_t buffer_growth_bytes;
+} ape_step_stats;
+
+uint32_t ape_world_get_step_stats(const ape_world* w, ape_step_stats* out);
+
 // Introspection helpers
 uint32_t ape_world_is_alive(const ape_world* w, uint32_t id); // 0 false, 1 true
+uint32_t ape_world_is_static(const ape_world* w, uint32_t id); // 1 for live bodies created with mass <= 0
 size_t ape_world_body_count(const ape_world* w);
+size_t ape_world_max_bodies(const ape_world* w); // capacity of the handle layout
 
 #ifdef __cplusplus
 }
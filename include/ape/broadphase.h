@@ -1,14 +1,20 @@
 #pragma once
 
-// Minimal broadphase scaffolding (AABB + naive O(n^2) overlap finder)
-// Future work: incremental SAP/BVH; this is for early tests only.
+// Broadphase: the AABB type and the overlap finders built on it: a naive
+// O(n^2) reference, a one-shot 1D sweep, a persistent incremental
+// sweep-and-prune (the World's default), a uniform spatial hash grid for
+// similarly sized boxes and a region-partitioned sweep that runs on a
+// JobSystem. The dynamic AABB tree backend lives in dynamic_tree.h.
 
 #include <cstddef>
 #include <cstdint>
+#include <limits>
 #include <vector>
 
 namespace ape {
 
+class JobSystem;
+
 struct AABB {
     float min_x, min_y, min_z;
     float max_x, max_y, max_z;
@@ -20,8 +26,36 @@ inline bool aabb_overlaps(const AABB& a, const AABB& b) {
            (a.min_z <= b.max_z && a.max_z >= b.min_z);
 }
 
+// Box that overlaps nothing (min > max); used for unoccupied body slots
+inline AABB aabb_empty() {
+    const float inf = std::numeric_limits<float>::infinity();
+    return AABB{inf, inf, inf, -inf, -inf, -inf};
+}
+
 struct Pair { std::uint32_t a, b; };
 
+inline bool pair_less(const Pair& l, const Pair& r) {
+    return l.a < r.a || (l.a == r.a && l.b < r.b);
+}
+
+// Collision layers: a box belongs to the categories set in `category` and
+// pairs only with boxes whose category shares a bit with its `mask`, both
+// ways. The default filter is in category 1 and accepts every category.
+struct CollisionFilter {
+    std::uint32_t category{1};
+    std::uint32_t mask{0xFFFFFFFFu};
+};
+
+inline bool filters_collide(const CollisionFilter& a, const CollisionFilter& b) {
+    return (a.category & b.mask) != 0 && (b.category & a.mask) != 0;
+}
+
+// The persistent backends below take an optional filters array (filters[i]
+// belongs to boxes[i]; nullptr = everything may pair). Rejected pairs are
+// dropped inside the sweep or query, before they are emitted, so they never
+// reach the narrowphase. Filters are read on every update; changing them
+// needs no rebuild.
+
 // Naive all-pairs broadphase; returns pairs with a < b
 void broadphase_naive(const AABB* boxes, std::size_t count, std::vector<Pair>& out);
 
@@ -29,4 +63,122 @@ void broadphase_naive(const AABB* boxes, std::size_t count, std::vector<Pair>& o
 // Returns candidate pairs with a < b, filtered by full 3D AABB overlap.
 void broadphase_sweep_1d(const AABB* boxes, std::size_t count, std::vector<Pair>& out, int axis = 0);
 
+// Persistent sweep-and-prune along one axis. The sorted endpoint list is kept
+// between updates and repaired with insertion sort, which is close to O(n) when
+// boxes move little from frame to frame. A full sort only happens when the box
+// count changes. Pairs are reported sorted by (a, b) with a < b and filtered by
+// full 3D overlap. With track_deltas, added()/removed() hold the difference to
+// the previous update (one more pair-list copy and two merges per update, so
+// it is off by default and in the World).
+class SweepAndPrune {
+public:
+    explicit SweepAndPrune(int axis = 0, bool track_deltas = false) : axis_(axis), track_deltas_(track_deltas) {}
+
+    // boxes[i] is the AABB of index i; boxes with min > max (see aabb_empty) never pair.
+    void update(const AABB* boxes, std::size_t count, std::vector<Pair>& out,
+                const CollisionFilter* filters = nullptr);
+
+    // Empty unless constructed with track_deltas
+    const std::vector<Pair>& added() const { return added_; }
+    const std::vector<Pair>& removed() const { return removed_; }
+
+    // Drop all persistent state (next update rebuilds from scratch)
+    void clear();
+
+private:
+    // key = (index << 1) | is_max; sorted by (value, is_max, index) so ties are
+    // ordered the same way by the initial sort and by insertion-sort repairs
+    struct Endpoint { float value; std::uint32_t key; };
+
+    void rebuild(const AABB* boxes, std::size_t count);
+
+    int axis_;
+    bool track_deltas_;
+    std::size_t count_{0};
+    std::vector<Endpoint> endpoints_;
+    std::vector<std::uint32_t> active_;
+    std::vector<std::uint32_t> active_pos_; // index -> slot in active_ (npos when inactive)
+    std::vector<Pair> prev_pairs_;
+    std::vector<Pair> added_;
+    std::vector<Pair> removed_;
+};
+
+// Uniform spatial hash grid. Each box is binned into every cell it touches;
+// entries are stored flat and radix-sorted by hashed cell key, so cells are
+// contiguous runs with no per-cell containers. A pair is only emitted from the
+// cell holding the min corner of the two boxes' intersection, so no duplicate
+// removal pass is needed. Expected O(n) for evenly sized boxes; boxes spanning
+// more than `max_cells_per_box` cells are not binned but tested against the
+// binned boxes and each other (O(L*n) for L such boxes).
+// Pairs are reported sorted by (a, b) with a < b (same as SweepAndPrune).
+class SpatialHashGrid {
+public:
+    static constexpr std::uint32_t max_cells_per_box = 64;
+
+    // cell_size <= 0 selects the cell size automatically on each update
+    // (median of the boxes' largest extents).
+    explicit SpatialHashGrid(float cell_size = 0.0f) : fixed_cell_size_(cell_size) {}
+
+    void update(const AABB* boxes, std::size_t count, std::vector<Pair>& out,
+                const CollisionFilter* filters = nullptr);
+    void clear();
+
+    // Cell size used by the last update
+    float cellSize() const { return cell_size_; }
+
+private:
+    struct Entry { std::uint32_t key; std::int32_t cx, cy, cz; std::uint32_t index; };
+
+    float fixed_cell_size_;
+    float cell_size_{1.0f};
+    std::vector<float> extents_;
+    std::vector<Entry> entries_;
+    std::vector<Entry> sort_tmp_;
+    std::vector<std::uint32_t> large_; // oversized boxes, by index
+    std::vector<std::uint32_t> small_; // binned boxes, by index
+};
+
+// Region-partitioned sort-and-sweep for wide worlds. The X/Z extent of the
+// boxes is split into a grid of regions; every box is registered in each
+// region it touches, and each region sorts and sweeps its own boxes along X
+// independently (one JobSystem task per region when `jobs` is given). A pair is
+// only reported by the region holding the X/Z min corner of the two boxes'
+// intersection, so straddling boxes produce no duplicates. The per-region
+// lists are merged with a counting sort on `a`: pairs come out sorted by
+// (a, b) with a < b, identical to the other backends for any region layout
+// and thread count. Boxes much larger than a region land in many regions;
+// keep them few (floors are better split or made static).
+class RegionBroadphase {
+public:
+    static constexpr std::size_t boxes_per_region = 512; // automatic layout target
+    static constexpr std::uint32_t max_regions_per_axis = 64;
+
+    // regions_x/regions_z == 0 picks the layout on each update from the box
+    // count and the aspect of the X/Z bounds
+    explicit RegionBroadphase(std::uint32_t regions_x = 0, std::uint32_t regions_z = 0)
+        : fixed_x_(regions_x), fixed_z_(regions_z) {}
+
+    void update(const AABB* boxes, std::size_t count, std::vector<Pair>& out, JobSystem* jobs = nullptr,
+                const CollisionFilter* filters = nullptr);
+    void clear();
+
+    // Layout used by the last update
+    std::uint32_t regionsX() const { return regions_x_; }
+    std::uint32_t regionsZ() const { return regions_z_; }
+
+private:
+    struct Item { float min_x; std::uint32_t index; };
+
+    void sweep_region(const AABB* boxes, const CollisionFilter* filters, std::uint32_t region);
+
+    std::uint32_t fixed_x_, fixed_z_;
+    std::uint32_t regions_x_{1}, regions_z_{1};
+    float origin_x_{0}, origin_z_{0};
+    float inv_size_x_{0}, inv_size_z_{0}; // regions per unit length
+    std::vector<std::uint32_t> region_start_;    // region r owns items_[start[r], start[r+1])
+    std::vector<Item> items_;
+    std::vector<std::vector<Pair>> region_pairs_; // per-region output, unsorted
+    std::vector<std::uint32_t> pair_start_;       // counting sort buckets by a
+};
+
 } // namespace ape
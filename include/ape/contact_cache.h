@@ -0,0 +1,65 @@
+#pragma once
+
+// Persistent contact impulse cache for solver warm-starting.
+// Open-addressing hash table keyed by body pair (a, b). Slots carry a stamp so
+// starting a new frame is O(1); storage only grows when the contact count
+// exceeds every previous frame, so steady-state frames never allocate.
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "ape/ape.h"
+
+namespace ape {
+
+class ContactCache {
+public:
+    struct Entry {
+        std::uint64_t key;   // (a << 32) | b
+        std::uint32_t stamp; // entry is live when stamp == current stamp
+        float normal_impulse;
+        Vec3 tangent_impulse;
+        std::uint32_t pad;   // always 0: no indeterminate padding in snapshot bytes
+    };
+    static_assert(sizeof(Entry) == 32, "Entry layout is part of the snapshot format");
+
+    // Start a new frame expecting up to `expected` inserts; drops all entries.
+    void reset(std::size_t expected);
+
+    // Insert or overwrite the impulses for pair (a, b)
+    void insert(std::uint32_t a, std::uint32_t b, float normal_impulse, const Vec3& tangent_impulse);
+
+    // Impulses stored for pair (a, b), or nullptr
+    const Entry* find(std::uint32_t a, std::uint32_t b) const;
+
+    std::size_t size() const { return size_; }
+    std::size_t capacity() const { return slots_.size(); }
+    void clear();
+
+    // Raw table for world snapshots: restore() from a byte copy of slots()
+    // plus stamp() and size() reproduces this cache exactly. Returns false and
+    // leaves the cache unchanged unless the table could have come from slots():
+    // a power-of-two slot count at most half full, `size` live entries.
+    std::span<const Entry> slots() const { return slots_; }
+    std::uint32_t stamp() const { return stamp_; }
+    bool restore(const std::byte* slots, std::size_t slot_count, std::uint32_t stamp, std::size_t size);
+
+private:
+    static std::uint64_t make_key(std::uint32_t a, std::uint32_t b) {
+        return (static_cast<std::uint64_t>(a) << 32) | b;
+    }
+    static std::size_t hash(std::uint64_t key) {
+        // 64-bit mix (splitmix64 finalizer)
+        key ^= key >> 30; key *= 0xbf58476d1ce4e5b9ull;
+        key ^= key >> 27; key *= 0x94d049bb133111ebull;
+        key ^= key >> 31;
+        return static_cast<std::size_t>(key);
+    }
+
+    std::vector<Entry> slots_; // power-of-two size, load factor <= 1/2
+    std::uint32_t stamp_{1};
+    std::size_t size_{0};
+};
+
+} // namespace ape
@@ -0,0 +1,46 @@
+#pragma once
+
+// Graph coloring of contacts for the parallel solver. Contacts of one color
+// share no finite-mass body, so a color batch can be solved concurrently
+// without races. Bodies with mass <= 0 are never written by the solver and do
+// not constrain the coloring (a floor does not serialize every contact on it).
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "ape/narrowphase.h"
+
+namespace ape {
+
+class ContactColoring {
+public:
+    // Colors tracked per body; contacts that find all of them taken go to a
+    // final overflow batch that is solved serially.
+    static constexpr std::size_t max_colors = 64;
+
+    // Greedy coloring of contacts[order[0..count)] in list order: each contact
+    // takes the lowest color not yet used by either of its finite-mass bodies.
+    void build(std::size_t body_count,
+               const float* mass,
+               const Contact* contacts,
+               const std::uint32_t* order,
+               std::size_t count);
+
+    // Batches in color order; the overflow batch, if any, is last.
+    std::size_t batchCount() const { return batch_start_.empty() ? 0 : batch_start_.size() - 1; }
+    std::span<const std::uint32_t> batch(std::size_t k) const {
+        return {contacts_.data() + batch_start_[k], batch_start_[k + 1] - batch_start_[k]};
+    }
+    // True if batch k may be solved in parallel (false only for the overflow batch)
+    bool independent(std::size_t k) const { return !has_overflow_ || k + 1 < batchCount(); }
+
+private:
+    std::vector<std::uint64_t> body_colors_; // bit c set: body already has a contact of color c
+    std::vector<std::uint8_t> color_;        // per listed contact (max_colors = overflow)
+    std::vector<std::uint32_t> batch_start_;
+    std::vector<std::uint32_t> contacts_;
+    bool has_overflow_{false};
+};
+
+} // namespace ape
@@ -0,0 +1,71 @@
+#pragma once
+
+// Vectorized contact solver over SoA constraint rows. Contacts of each color
+// batch (see ContactColoring) are packed into groups of laneWidth() rows that
+// share no finite-mass body, so one group is solved per SIMD instruction
+// stream: AVX2 (8 lanes), SSE (4 lanes) or a scalar fallback (1 lane),
+// chosen at build time (APE_SIMD in CMake). The update is the same PGS step
+// as the scalar solver in World::step, evaluated lane-wise with masks
+// instead of branches.
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "ape/ape.h"
+#include "ape/contact_coloring.h"
+#include "ape/narrowphase.h"
+
+namespace ape {
+
+class ContactRows {
+public:
+    // Lanes per group for this build (8, 4 or 1)
+    static std::size_t laneWidth();
+
+    // Pack the colored contacts into rows, seeding accumulated impulses from
+    // impulses_n/impulses_t (indexed by contact). Contacts between two bodies of
+    // mass <= 0 are dropped. The overflow batch gets one active lane per group
+    // so its contacts are still solved one after another.
+    void build(const ContactColoring& coloring,
+               const Contact* contacts,
+               const float* mass,
+               const float* impulses_n,
+               const Vec3* impulses_t);
+
+    // Apply the accumulated impulses to velocities (warm start)
+    void warmStart(Vec3* vel, JobSystem* jobs) const;
+
+    // `iterations` PGS sweeps over the batches in color order; groups of an
+    // independent batch are split across `jobs` when given.
+    void solve(Vec3* vel, float dt, int iterations, float baumgarte, JobSystem* jobs);
+
+    // Write accumulated impulses back, indexed by contact
+    void storeImpulses(float* impulses_n, Vec3* impulses_t) const;
+
+    // Lanes in use, including padding
+    std::size_t rowCount() const { return contact_.size(); }
+
+private:
+    // Row storage, one entry per lane; padding lanes have zero inverse masses
+    // and are never written back.
+    struct Rows {
+        std::vector<std::uint32_t> a, b;
+        std::vector<float> nx, ny, nz;
+        std::vector<float> penetration, friction, restitution;
+        std::vector<float> inv_mass_a, inv_mass_b;
+        std::vector<float> normal_mass; // 1 / (inv_mass_a + inv_mass_b)
+        std::vector<float> bias;        // Baumgarte velocity bias for the current solve
+        std::vector<float> jn, jtx, jty, jtz; // accumulated impulses
+    };
+
+    template <class Kernel>
+    void run(JobSystem* jobs, Kernel&& kernel) const;
+
+    Rows rows_;
+    std::vector<std::uint32_t> contact_;     // per lane: contact index (~0u for padding)
+    std::vector<std::uint8_t> active_;       // per group: number of active lanes
+    std::vector<std::uint32_t> group_start_; // per batch: first group
+    std::vector<std::uint8_t> independent_;  // per batch: groups may run concurrently
+};
+
+} // namespace ape
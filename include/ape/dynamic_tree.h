@@ -0,0 +1,111 @@
+#pragma once
+
+// Dynamic AABB tree (incrementally updated BVH) and a broadphase built on it.
+// Leaves store fat AABBs (tight box grown by a margin) so small motions do not
+// touch the tree; internal nodes are kept balanced with AVL-style rotations.
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "ape/broadphase.h"
+
+namespace ape {
+
+class DynamicTree {
+public:
+    static constexpr std::int32_t null_node = -1;
+
+    explicit DynamicTree(float margin = 0.1f) : margin_(margin) {}
+
+    // Insert a leaf for `box` (stored fattened by the margin); returns its proxy id
+    std::int32_t createProxy(const AABB& box, std::uint32_t user);
+    void destroyProxy(std::int32_t proxy);
+    // Reinsert the leaf if `box` left its fat AABB; returns true if the tree changed
+    bool moveProxy(std::int32_t proxy, const AABB& box);
+
+    const AABB& fatAABB(std::int32_t proxy) const { return nodes_[static_cast<std::size_t>(proxy)].box; }
+    std::uint32_t userData(std::int32_t proxy) const { return nodes_[static_cast<std::size_t>(proxy)].user; }
+
+    // Call fn(user) for every leaf whose fat AABB overlaps `box`. Pending nodes
+    // live on a fixed stack (a balanced tree needs about its height); past 256
+    // they spill to a heap vector instead of being dropped.
+    template <class F>
+    void query(const AABB& box, F&& fn) const {
+        if (root_ == null_node) return;
+        std::array<std::int32_t, 256> stack;
+        std::vector<std::int32_t> spill;
+        std::size_t top = 0;
+        stack[top++] = root_;
+        while (top > 0 || !spill.empty()) {
+            std::int32_t index;
+            if (!spill.empty()) { index = spill.back(); spill.pop_back(); }
+            else index = stack[--top];
+            const Node& node = nodes_[static_cast<std::size_t>(index)];
+            if (!aabb_overlaps(node.box, box)) continue;
+            if (node.child1 == null_node) {
+                fn(node.user);
+            } else if (top + 2 <= stack.size()) {
+                stack[top++] = node.child1;
+                stack[top++] = node.child2;
+            } else {
+                spill.push_back(node.child1);
+                spill.push_back(node.child2);
+            }
+        }
+    }
+
+    // Height of the root (0 for a single leaf, -1 when empty)
+    int height() const { return root_ == null_node ? -1 : nodes_[static_cast<std::size_t>(root_)].height; }
+    std::size_t proxyCount() const { return leaf_count_; }
+
+    // Check parent links, heights, balance and box containment (for tests)
+    bool validate() const;
+
+    void clear();
+
+private:
+    struct Node {
+        AABB box;
+        std::int32_t parent;  // next free node when on the free list
+        std::int32_t child1;  // null_node for leaves
+        std::int32_t child2;
+        std::int32_t height;  // leaf = 0, free = -1
+        std::uint32_t user;
+    };
+
+    std::int32_t allocateNode();
+    void freeNode(std::int32_t node);
+    void insertLeaf(std::int32_t leaf);
+    void removeLeaf(std::int32_t leaf);
+    std::int32_t balance(std::int32_t a);
+    bool validateNode(std::int32_t index, std::int32_t parent) const;
+
+    float margin_;
+    std::vector<Node> nodes_;
+    std::int32_t root_{null_node};
+    std::int32_t free_list_{null_node};
+    std::size_t leaf_count_{0};
+};
+
+// Broadphase over a DynamicTree with one proxy per index. Proxies are created,
+// moved and destroyed to follow the boxes; every index then queries the tree.
+// Pairs are filtered by tight 3D overlap (and CollisionFilter, if given) and
+// reported sorted by (a, b), a < b, i.e. the same set and order as SweepAndPrune.
+class DynamicTreeBroadphase {
+public:
+    explicit DynamicTreeBroadphase(float margin = 0.1f) : tree_(margin) {}
+
+    // boxes[i] is the AABB of index i; boxes with min > max (see aabb_empty) have no proxy.
+    void update(const AABB* boxes, std::size_t count, std::vector<Pair>& out,
+                const CollisionFilter* filters = nullptr);
+    void clear();
+
+    const DynamicTree& tree() const { return tree_; }
+
+private:
+    DynamicTree tree_;
+    std::vector<std::int32_t> proxy_of_; // index -> proxy (null_node if none)
+};
+
+} // namespace ape
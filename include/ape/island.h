@@ -0,0 +1,66 @@
+#pragma once
+
+// Simulation islands: connected components of the contact graph.
+// Bodies with mass <= 0 (infinite mass) do not link islands, so a floor shared
+// by many piles does not merge them. Every alive (or listed) body belongs to
+// exactly one island; each contact belongs to the island of its finite-mass body.
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "ape/narrowphase.h"
+
+namespace ape {
+
+class IslandBuilder {
+public:
+    static constexpr std::uint32_t npos = 0xFFFFFFFFu;
+
+    // Union-find over contacts. Islands are numbered in order of their lowest
+    // body index; bodies and contacts within an island are in ascending order.
+    void build(std::size_t body_count,
+               const std::uint8_t* alive,
+               const float* mass,
+               const Contact* contacts,
+               std::size_t contact_count);
+
+    // Same over an explicit body list (every finite-mass body of the contacts
+    // included; islands are numbered in list order); other bodies get no
+    // island. Work is proportional to the list and the contacts, not to
+    // body_count, so a world can island only its awake bodies.
+    void build(std::size_t body_count,
+               std::span<const std::uint32_t> bodies,
+               const float* mass,
+               const Contact* contacts,
+               std::size_t contact_count);
+
+    std::size_t islandCount() const { return body_start_.empty() ? 0 : body_start_.size() - 1; }
+
+    std::span<const std::uint32_t> bodies(std::size_t island) const {
+        return {bodies_.data() + body_start_[island], body_start_[island + 1] - body_start_[island]};
+    }
+    std::span<const std::uint32_t> contacts(std::size_t island) const {
+        return {contacts_.data() + contact_start_[island], contact_start_[island + 1] - contact_start_[island]};
+    }
+
+    // Island of a body (npos for dead slots) and of a contact
+    std::uint32_t islandOfBody(std::size_t body) const { return body_island_[body]; }
+    std::uint32_t islandOfContact(std::size_t contact) const { return contact_island_[contact]; }
+
+private:
+    std::uint32_t find(std::uint32_t i);
+
+    std::vector<std::uint32_t> listed_; // alive bodies of the mask variant
+    std::vector<std::uint32_t> parent_;
+    std::vector<std::uint32_t> root_island_;
+    std::vector<std::uint32_t> body_island_;
+    std::vector<std::uint32_t> contact_island_;
+    std::vector<std::uint32_t> cursor_; // per-island write positions
+    std::vector<std::uint32_t> body_start_;
+    std::vector<std::uint32_t> bodies_;
+    std::vector<std::uint32_t> contact_start_;
+    std::vector<std::uint32_t> contacts_;
+};
+
+} // namespace ape
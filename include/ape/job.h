@@ -1,30 +1,167 @@
 #pragma once
-#include <functional>
 #include <vector>
 #include <thread>
 #include <atomic>
 #include <condition_variable>
-#include <queue>
+#include <mutex>
+#include <memory>
+#include <new>
+#include <cstddef>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
 
 namespace ape {
 
+// Completion handle: counts jobs submitted against it that have not finished yet.
+// Waiting on a counter only waits for those jobs (see JobSystem::wait).
+class JobCounter {
+public:
+    bool done() const { return pending_.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class JobSystem;
+    std::atomic<std::uint32_t> pending_{0};
+};
+
+// Fixed-size job with inline storage for its callable (no heap allocation).
+// Callables must be trivially copyable and fit in `storage_size` bytes; capture
+// large state by reference or pointer.
+class Job {
+public:
+    static constexpr std::size_t storage_size = 48;
+
+    Job() = default;
+
+    template <class F>
+    explicit Job(F&& f, JobCounter* counter = nullptr) : counter_(counter) {
+        using Fn = std::decay_t<F>;
+        static_assert(sizeof(Fn) <= storage_size, "Job callable too large for inline storage; capture by reference");
+        static_assert(alignof(Fn) <= alignof(std::max_align_t), "Job callable over-aligned");
+        static_assert(std::is_trivially_copyable_v<Fn> && std::is_trivially_destructible_v<Fn>,
+                      "Job callable must be trivially copyable (e.g. a lambda capturing pointers/references/scalars)");
+        ::new (static_cast<void*>(storage_)) Fn(std::forward<F>(f));
+        invoke_ = [](void* p) { (*static_cast<Fn*>(p))(); };
+    }
+
+    void run() { invoke_(storage_); }
+    JobCounter* counter() const { return counter_; }
+
+private:
+    alignas(std::max_align_t) unsigned char storage_[storage_size]{};
+    void (*invoke_)(void*) = nullptr;
+    JobCounter* counter_ = nullptr;
+};
+
+// Work-stealing job system. Each worker owns a bounded deque: it pushes and pops
+// at the back, idle workers steal from the front of other deques. Threads that
+// are not workers submit to a shared injection deque. Waiting threads execute
+// pending jobs instead of blocking.
 class JobSystem {
 public:
     explicit JobSystem(unsigned workers = std::thread::hardware_concurrency());
+    // Finishes every job still queued before stopping the workers.
     ~JobSystem();
 
-    void enqueue(std::function<void()> job);
+    JobSystem(const JobSystem&) = delete;
+    JobSystem& operator=(const JobSystem&) = delete;
+
+    // Submit a job; if `counter` is given it is incremented now and decremented
+    // when the job finishes. Runs the job inline if the target deque is full.
+    void submit(const Job& job);
+
+    template <class F>
+    void enqueue(F&& job, JobCounter* counter = nullptr) { submit(Job(std::forward<F>(job), counter)); }
+
+    // Run pending jobs on the calling thread until `counter` reaches zero.
+    void wait(const JobCounter& counter);
+
+    // Run pending jobs until every submitted job has finished.
     void wait_idle();
 
+    unsigned worker_count() const { return worker_count_; }
+
+    // Split [0, count) into chunks of `grain` items and run fn(begin, end) for
+    // each chunk. Workers and the calling thread claim chunks from a shared
+    // cursor; returns once every chunk has finished. Chunk boundaries depend
+    // only on count and grain.
+    template <class F>
+    void parallel_for(std::size_t count, std::size_t grain, F&& fn) {
+        if (count == 0) return;
+        if (grain == 0) grain = 1;
+        const std::size_t chunks = (count + grain - 1) / grain;
+        if (chunks == 1) { fn(std::size_t{0}, count); return; }
+        std::atomic<std::size_t> next{0};
+        auto body = [&fn, &next, count, grain, chunks] {
+            for (std::size_t c = next.fetch_add(1, std::memory_order_relaxed); c < chunks;
+                 c = next.fetch_add(1, std::memory_order_relaxed)) {
+                const std::size_t b = c * grain;
+                fn(b, (b + grain < count) ? b + grain : count);
+            }
+        };
+        run_split(body, chunks);
+    }
+
+    // Deterministic chunked reduction: map(begin, end) -> T per chunk, then
+    // combine(acc, partial) in chunk order starting from `identity`. The grain is
+    // widened so that at most `max_reduce_chunks` partials are kept (on the stack).
+    static constexpr std::size_t max_reduce_chunks = 64;
+
+    template <class T, class Map, class Combine>
+    T parallel_reduce(std::size_t count, std::size_t grain, T identity, Map&& map, Combine&& combine) {
+        if (count == 0) return identity;
+        if (grain == 0) grain = 1;
+        if ((count + grain - 1) / grain > max_reduce_chunks) grain = (count + max_reduce_chunks - 1) / max_reduce_chunks;
+        const std::size_t chunks = (count + grain - 1) / grain;
+        T partials[max_reduce_chunks];
+        parallel_for(count, grain, [&](std::size_t b, std::size_t e) { partials[b / grain] = map(b, e); });
+        T acc = identity;
+        for (std::size_t c = 0; c < chunks; ++c) acc = combine(acc, partials[c]);
+        return acc;
+    }
+
 private:
-    void worker_loop();
+    static constexpr std::size_t queue_capacity = 512;
+
+    // Bounded deque guarded by a spinlock (owner: back, thieves: front).
+    struct alignas(64) WorkQueue {
+        std::atomic_flag lock = ATOMIC_FLAG_INIT;
+        std::size_t head{0}; // next to steal
+        std::size_t tail{0}; // one past the owner's end
+        Job ring[queue_capacity];
+
+        bool push(const Job& job);
+        bool pop(Job& out);
+        bool steal(Job& out);
+    };
+
+    // Submit up to (chunks - 1) copies of `body` for workers, run it on the
+    // calling thread as well, then wait for the submitted copies.
+    template <class Body>
+    void run_split(Body& body, std::size_t chunks) {
+        JobCounter counter;
+        std::size_t helpers = chunks - 1;
+        if (helpers > worker_count_) helpers = worker_count_;
+        for (std::size_t i = 0; i < helpers; ++i) enqueue([&body] { body(); }, &counter);
+        body();
+        wait(counter);
+    }
+
+    bool try_run_one(unsigned self);
+    void execute(Job& job);
+    void worker_loop(unsigned index);
 
     std::vector<std::thread> threads_;
-    std::mutex mtx_;
-    std::condition_variable cv_;
-    std::queue<std::function<void()>> q_;
+    std::unique_ptr<WorkQueue[]> queues_; // [0, workers) per worker, [workers] injection
+    unsigned worker_count_{0};
+    unsigned queue_count_{0};
+
+    std::atomic<std::size_t> queued_{0};      // jobs sitting in deques
+    std::atomic<std::size_t> outstanding_{0}; // submitted and not yet finished
+    std::atomic<int> sleepers_{0};
+    std::mutex sleep_mtx_;
+    std::condition_variable sleep_cv_;
     std::atomic<bool> quit_{false};
-    std::atomic<int> active_{0};
 };
 
 }
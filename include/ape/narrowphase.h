@@ -34,7 +34,10 @@ void generate_contacts_sphere_sphere(const Vec3* positions,
                                      const std::vector<Pair>& pairs,
                                      std::vector<Contact>& out);
 
-// Unified narrowphase dispatcher handling all shape combinations
+// Unified narrowphase dispatcher handling all shape combinations. Pairs are
+// bucketed by shape combination (sphere-sphere, sphere-box, box-box) and each
+// bucket runs a SIMD kernel over blocks of pairs; contacts are appended bucket
+// by bucket, in pair order within a bucket.
 // Inputs:
 // - positions, shape_types, sphere_radii, box_half_extents: per-body arrays
 // - frictions, restitutions: material properties
@@ -51,6 +54,20 @@ void generate_contacts(const Vec3* positions,
                        const std::vector<Pair>& pairs,
                        std::vector<Contact>& out);
 
+// Same as above over a sub-range of pairs; lets callers split narrowphase into
+// independent chunks. Output depends only on the given range, so equal chunks
+// give equal contact order whatever thread runs them.
+void generate_contacts(const Vec3* positions,
+                       const uint8_t* shape_types,
+                       const float* sphere_radii,
+                       const Vec3* box_half_extents,
+                       const float* frictions,
+                       const float* restitutions,
+                       std::size_t count,
+                       const Pair* pairs,
+                       std::size_t pair_count,
+                       std::vector<Contact>& out);
+
 } // namespace ape
 
 
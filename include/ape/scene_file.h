@@ -0,0 +1,36 @@
+#pragma once
+
+// Binary scene files for instant world loading.
+// A scene file is a fixed 64-byte header followed by a world snapshot payload
+// (World::saveSnapshot layout: every SoA array as one 8-byte aligned block).
+// loadScene maps the file and copies each block straight into the World's
+// arrays, so loading costs a page-in and a memcpy per array, not a call per
+// body. Files are native-endian; a file written on a machine of the other
+// endianness is rejected.
+
+#include <cstdint>
+#include "ape/ape.h"
+
+namespace ape {
+
+struct SceneInfo {
+    std::uint32_t version{0};
+    std::uint32_t index_bits{0}; // handle layout the scene was saved with (WorldDesc::index_bits)
+    std::uint64_t body_count{0};
+    std::uint64_t slot_count{0};
+};
+
+// Write the current state of `world` (bodies and their collision filters,
+// handles, sleep state, warm-start cache) to `path`. World settings (gravity,
+// solver, ...) are not stored.
+bool saveScene(const World& world, const char* path);
+
+// Replace the state of `world` with the scene at `path`. Fails, leaving the
+// world unchanged, if the file is missing or malformed or was saved with a
+// different handle layout (construct the World from readSceneInfo().index_bits).
+bool loadScene(World& world, const char* path);
+
+// Header of the scene at `path` without loading it
+bool readSceneInfo(const char* path, SceneInfo& out);
+
+} // namespace ape
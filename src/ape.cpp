@@ -1,17 +1,78 @@
 #include "ape/ape.h"
+#include <algorithm>
+#include <chrono>
 #include <vector>
 #include <cmath>
 #include <cstdint>
+#include <cstring>
 #include <limits>
+#include <memory>
+#include <type_traits>
 #include "ape/broadphase.h"
+#include "ape/dynamic_tree.h"
 #include "ape/narrowphase.h"
+#include "ape/contact_cache.h"
+#include "ape/contact_coloring.h"
+#include "ape/contact_rows.h"
+#include "ape/island.h"
+#include "ape/job.h"
+#include "foundation/frame_arena.h"
+
+// Step statistics (World::stepStats). APE_STATS(...) expands to its argument
+// only when enabled, so a disabled build carries no timing or counting code.
+#ifndef APE_ENABLE_STATS
+#define APE_ENABLE_STATS 0
+#endif
+#if APE_ENABLE_STATS
+#define APE_STATS(...) __VA_ARGS__
+#else
+#define APE_STATS(...)
+#endif
 
 namespace ape {
 
+#if APE_ENABLE_STATS
+// Lap timer for the stages of step()
+struct StageClock {
+    std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    std::chrono::steady_clock::time_point last = start;
+    double lap() {
+        const auto now = std::chrono::steady_clock::now();
+        const double ms = std::chrono::duration<double, std::milli>(now - last).count();
+        last = now;
+        return ms;
+    }
+    double total() const { return std::chrono::duration<double, std::milli>(last - start).count(); }
+};
+#endif
+
+// Minimum items per job for the data-parallel stages of step()
+static constexpr std::size_t body_grain = 1024;
+static constexpr std::size_t pair_grain = 256;
+
+// Run fn(begin, end) over [0, count), split across the job system when one is
+// attached and the range is large enough to be worth it.
+template <class F>
+static void for_range(JobSystem* jobs, std::size_t count, std::size_t grain, F&& fn) {
+    if (jobs && count > grain) jobs->parallel_for(count, grain, fn);
+    else if (count > 0) fn(std::size_t{0}, count);
+}
+
 struct World::Impl {
-    // Stable 32-bit handle: [high 16 bits generation][low 16 bits index]
-    static constexpr uint32_t INDEX_BITS = 16;
-    static constexpr uint32_t INDEX_MASK = (1u << INDEX_BITS) - 1u; // 0xFFFF
+    // Stable 32-bit handle: [generation : 32 - index_bits][index : index_bits]
+    // (WorldDesc::index_bits, 16/16 by default). The all-ones index is never
+    // issued, so UINT32_MAX is never a valid handle.
+    static constexpr uint32_t min_index_bits = 8;
+    static constexpr uint32_t max_index_bits = 28;
+    uint32_t index_bits;
+    uint32_t index_mask;
+    uint32_t generation_mask;
+
+    explicit Impl(const WorldDesc& desc)
+        : index_bits(desc.index_bits < min_index_bits ? min_index_bits
+                     : desc.index_bits > max_index_bits ? max_index_bits : desc.index_bits),
+          index_mask((1u << index_bits) - 1u),
+          generation_mask(0xFFFFFFFFu >> index_bits) {}
 
     // SoA storage
     std::vector<Vec3> pos;
@@ -22,11 +83,39 @@ struct World::Impl {
     std::vector<Vec3> box_half_extents;
     std::vector<float> friction;
     std::vector<float> restitution;
-    std::vector<uint16_t> gen; // per-slot generation counters
-    std::vector<uint16_t> alive; // 1 if occupied, 0 if free (small, cache-friendly)
-    std::vector<uint16_t> awake; // 1 if awake, 0 if sleeping
+    std::vector<CollisionFilter> filter; // collision category/mask
+    std::vector<uint32_t> gen; // per-slot generation counters (generation_mask bits)
+    std::vector<uint8_t> alive; // 1 if occupied, 0 if free (small, cache-friendly)
+    std::vector<uint8_t> awake; // 1 if awake, 0 if sleeping or static
     std::vector<float> sleep_timer; // accumulates time below motion threshold
-    std::vector<uint16_t> free_list; // indices available for reuse
+    std::vector<uint32_t> free_list; // indices available for reuse
+    // Dense index lists mirroring alive/awake so per-body stages scale with
+    // live/awake bodies rather than slot capacity. Updated in O(1) by
+    // swap-remove; *_slot maps a body index to its list position (or npos).
+    static constexpr uint32_t npos = 0xFFFFFFFFu;
+    std::vector<uint32_t> alive_list;
+    std::vector<uint32_t> alive_slot;
+    std::vector<uint32_t> awake_list;
+    std::vector<uint32_t> awake_slot;
+
+    // Inactive bodies, static (mass <= 0) or sleeping, have no box in `aabbs`
+    // (their slot holds aabb_empty()), so the dynamic broadphase never sees
+    // them. Their boxes live in static_tree and sleep_tree, which only awake
+    // boxes query: static-static, static-sleeping and sleeping-sleeping pairs
+    // are never formed, and a sleeping body's box is computed once, when it
+    // falls asleep. Two trees, so a floor spanning the world does not inflate
+    // the nodes above the sleeping bodies. Derived from the arrays above (not
+    // in snapshots).
+    DynamicTree static_tree{0.0f};
+    DynamicTree sleep_tree{0.0f};
+    std::vector<int32_t> inactive_proxy; // slot -> proxy in its tree (null_node if none)
+    // Bodies that fell asleep as one island form a ring through sleep_next
+    // (npos while awake), so waking any of them wakes the whole island even
+    // though sleeping bodies no longer have contacts with each other
+    std::vector<uint32_t> sleep_next;
+    // Set once any body gets a non-default filter; until then the broadphase
+    // gets no filter array and pays nothing for layers
+    bool filtered{false};
 
     // Sleep configuration
     static constexpr float sleep_linear_threshold = 0.01f;  // m/s
@@ -35,137 +124,639 @@ struct World::Impl {
 
     Vec3 gravity{0.f, -9.80665f, 0.f};
 
-    // Broadphase scratch and stats (temporary until proper pipeline)
+    // Broadphase: selected backend (persistent state) plus scratch and stats
+    BroadphaseType broadphase_type{BroadphaseType::SweepAndPrune};
+    SweepAndPrune sap{0};
+    DynamicTreeBroadphase tree_bp;
+    SpatialHashGrid grid_bp;
+    RegionBroadphase region_bp;
     std::vector<AABB> aabbs;
     std::vector<Pair> pairs;
     uint32_t last_pair_count{0};
+    std::vector<std::vector<Pair>> inactive_pair_chunks; // per-chunk awake-vs-inactive pairs
+    std::vector<Pair> inactive_pairs;
+    std::vector<Pair> merged_pairs;
     std::vector<Contact> contacts;
-    // Solver warm-start state
-    std::vector<Pair> warm_pairs;
-    std::vector<float> warm_impulses_n;  // per-pair accumulated normal impulse
-    std::vector<Vec3> warm_impulses_t;   // per-pair accumulated tangent impulse (friction)
-    std::vector<float> solver_impulses_n; // current-frame normal impulse
-    std::vector<Vec3> solver_impulses_t;  // current-frame tangent impulse
-
-    static uint32_t pack_handle(uint16_t index, uint16_t generation) {
-        return (static_cast<uint32_t>(generation) << INDEX_BITS) | static_cast<uint32_t>(index);
-    }
-    static uint16_t handle_index(uint32_t h) { return static_cast<uint16_t>(h & INDEX_MASK); }
-    static uint16_t handle_generation(uint32_t h) { return static_cast<uint16_t>(h >> INDEX_BITS); }
+    // Solver warm-start state: accumulated impulses from last frame keyed by body pair
+    ContactCache warm_cache;
+    // Islands rebuilt every step from the contact graph
+    IslandBuilder islands;
+    // Per-step scratch: the spans below point into frame_arena and are only
+    // valid until the next step resets it
+    FrameArena frame_arena;
+    std::span<uint8_t> island_sleeps;     // per island: 1 if it falls asleep this step
+    std::span<uint32_t> solve_islands;    // islands with contacts
+    // Contact solver mode; the graph-colored mode solves color batches in parallel
+    SolverType solver_type{SolverType::Sequential};
+    std::span<uint32_t> solve_list;       // contacts of solved islands (colored modes)
+    ContactColoring coloring;
+    ContactRows rows;                     // SoA constraint rows (Simd mode)
+    std::span<float> solver_impulses_n;   // current-frame normal impulse
+    std::span<Vec3> solver_impulses_t;    // current-frame tangent impulse
+
+    // Threading: borrowed or owned job system (nullptr = single-threaded)
+    JobSystem* jobs{nullptr};
+    std::unique_ptr<JobSystem> owned_jobs;
+    std::vector<std::vector<Contact>> contact_chunks; // per-chunk narrowphase output
+
+    StepStats stats;
+
+    // Heap bytes held by the per-step buffers above (StepStats::buffer_growth_bytes)
+    size_t step_buffer_bytes() const {
+        size_t bytes = aabbs.capacity() * sizeof(AABB) + pairs.capacity() * sizeof(Pair)
+                     + contacts.capacity() * sizeof(Contact) + frame_arena.capacity()
+                     + contact_chunks.capacity() * sizeof(std::vector<Contact>);
+        for (const auto& chunk : contact_chunks) bytes += chunk.capacity() * sizeof(Contact);
+        return bytes;
+    }
+
+    uint32_t pack_handle(uint32_t index, uint32_t generation) const {
+        return (generation << index_bits) | index;
+    }
+    uint32_t handle_index(uint32_t h) const { return h & index_mask; }
+    uint32_t handle_generation(uint32_t h) const { return h >> index_bits; }
+
+    static void list_add(std::vector<uint32_t>& list, std::vector<uint32_t>& slot, uint32_t i) {
+        if (i >= slot.size()) slot.resize(i + 1, npos);
+        if (slot[i] != npos) return;
+        slot[i] = static_cast<uint32_t>(list.size());
+        list.push_back(i);
+    }
+    static void list_remove(std::vector<uint32_t>& list, std::vector<uint32_t>& slot, uint32_t i) {
+        if (i >= slot.size() || slot[i] == npos) return;
+        const uint32_t at = slot[i];
+        const uint32_t last = list.back();
+        list[at] = last;
+        slot[last] = at;
+        list.pop_back();
+        slot[i] = npos;
+    }
+    // Resize every per-slot array to n slots; new slots are free (not alive)
+    void grow(size_t n) {
+        pos.resize(n, Vec3{0,0,0});
+        vel.resize(n, Vec3{0,0,0});
+        mass.resize(n, 0.0f);
+        shape_type.resize(n, static_cast<uint8_t>(ShapeType::Sphere));
+        sphere_radius.resize(n, 0.5f);
+        box_half_extents.resize(n, Vec3{0.5f,0.5f,0.5f});
+        friction.resize(n, 0.5f);
+        restitution.resize(n, 0.0f);
+        filter.resize(n, CollisionFilter{});
+        gen.resize(n, 0);
+        alive.resize(n, 0);
+        awake.resize(n, 0);
+        sleep_timer.resize(n, 0.0f);
+        alive_slot.resize(n, npos);
+        awake_slot.resize(n, npos);
+        inactive_proxy.resize(n, DynamicTree::null_node);
+        sleep_next.resize(n, npos);
+    }
+    void reserve(size_t n) {
+        pos.reserve(n); vel.reserve(n); mass.reserve(n);
+        shape_type.reserve(n); sphere_radius.reserve(n); box_half_extents.reserve(n);
+        friction.reserve(n); restitution.reserve(n); filter.reserve(n);
+        gen.reserve(n); alive.reserve(n); awake.reserve(n); sleep_timer.reserve(n);
+        alive_list.reserve(n); alive_slot.reserve(n);
+        awake_list.reserve(n); awake_slot.reserve(n);
+        inactive_proxy.reserve(n); sleep_next.reserve(n);
+        aabbs.reserve(n);
+    }
+    // Fill a free slot from desc; dynamic bodies start awake, static ones go
+    // into the static tree. Returns its handle.
+    uint32_t init_body(uint32_t idx, const RigidBodyDesc& d) {
+        pos[idx] = d.position;
+        mass[idx] = d.mass;
+        vel[idx] = is_static(idx) ? Vec3{0,0,0} : d.velocity;
+        shape_type[idx] = static_cast<uint8_t>(d.shape_type);
+        sphere_radius[idx] = d.sphere_radius > 0.0f ? d.sphere_radius : 0.5f;
+        box_half_extents[idx] = d.box_half_extents;
+        friction[idx] = d.friction;
+        restitution[idx] = d.restitution;
+        set_filter(idx, CollisionFilter{d.collision_category, d.collision_mask});
+        sleep_timer[idx] = 0.0f;
+        alive[idx] = 1;
+        list_add(alive_list, alive_slot, idx);
+        if (is_static(idx)) {
+            add_inactive(idx);
+        } else {
+            set_awake(idx);
+        }
+        return pack_handle(idx, gen[idx]);
+    }
+
+    bool is_static(uint32_t i) const { return mass[i] <= 0.0f; }
+    void set_filter(uint32_t i, const CollisionFilter& f) {
+        filter[i] = f;
+        if (f.category != CollisionFilter{}.category || f.mask != CollisionFilter{}.mask) filtered = true;
+    }
+    const CollisionFilter* filters() const { return filtered ? filter.data() : nullptr; }
+    DynamicTree& inactive_tree(uint32_t i) { return is_static(i) ? static_tree : sleep_tree; }
+    void add_inactive(uint32_t i) {
+        if (i < aabbs.size()) aabbs[i] = aabb_empty();
+        inactive_proxy[i] = inactive_tree(i).createProxy(body_aabb(i), i);
+    }
+    void remove_inactive(uint32_t i) {
+        if (inactive_proxy[i] == DynamicTree::null_node) return;
+        inactive_tree(i).destroyProxy(inactive_proxy[i]);
+        inactive_proxy[i] = DynamicTree::null_node;
+    }
+    // Put island `bodies` to sleep as one ring. Positions no longer change, so
+    // the box stored in sleep_tree stays exact until they wake.
+    void sleep_island(std::span<const uint32_t> bodies) {
+        for (size_t k = 0; k < bodies.size(); ++k) {
+            const uint32_t b = bodies[k];
+            set_asleep(b);
+            vel[b] = Vec3{0,0,0}; // no drift while asleep
+            add_inactive(b);
+            sleep_next[b] = bodies[k + 1 < bodies.size() ? k + 1 : 0];
+        }
+    }
+    // Wake a sleeping body and every body it fell asleep with
+    void wake(uint32_t i) {
+        if (!alive[i] || awake[i] || is_static(i)) return;
+        uint32_t b = i;
+        do {
+            const uint32_t next = sleep_next[b];
+            sleep_next[b] = npos;
+            remove_inactive(b);
+            set_awake(b);
+            sleep_timer[b] = 0.0f;
+            b = next;
+        } while (b != npos && b != i);
+    }
+    // Wake every sleeping island with a box overlapping `box`. Static bodies
+    // never pair with sleeping ones, so removing or moving a static must wake
+    // what may rest on it.
+    void wake_touching(const AABB& box) {
+        std::vector<uint32_t> hits;
+        sleep_tree.query(box, [&](uint32_t i) { hits.push_back(i); });
+        for (uint32_t i : hits) wake(i);
+    }
+    // Inactive trees and the filter flag from the body arrays (after a restore)
+    void rebuild_inactive() {
+        static_tree.clear();
+        sleep_tree.clear();
+        inactive_proxy.assign(pos.size(), DynamicTree::null_node);
+        filtered = false;
+        for (uint32_t i : alive_list) {
+            set_filter(i, filter[i]);
+            if (is_static(i)) set_asleep(i);
+            if (!awake[i]) add_inactive(i);
+        }
+    }
+
+    AABB body_aabb(uint32_t i) const {
+        const Vec3 p = pos[i];
+        const ShapeType stype = (i < shape_type.size()) ? static_cast<ShapeType>(shape_type[i]) : ShapeType::Sphere;
+        if (stype == ShapeType::Box) {
+            const Vec3 h = (i < box_half_extents.size()) ? box_half_extents[i] : Vec3{0.5f,0.5f,0.5f};
+            return AABB{p.x - h.x, p.y - h.y, p.z - h.z, p.x + h.x, p.y + h.y, p.z + h.z};
+        }
+        // Sphere
+        const float r = (i < sphere_radius.size() && sphere_radius[i] > 0.0f) ? sphere_radius[i] : 0.5f;
+        return AABB{p.x - r, p.y - r, p.z - r, p.x + r, p.y + r, p.z + r};
+    }
+    void set_awake(uint32_t i) { awake[i] = 1; list_add(awake_list, awake_slot, i); }
+    void set_asleep(uint32_t i) { awake[i] = 0; list_remove(awake_list, awake_slot, i); }
+
+    // Every array a snapshot carries, in snapshot order (the warm-start table
+    // follows them). Broadphase backends are not included: they report pairs in
+    // canonical order whatever their internal state, so they only need the boxes.
+    // With several worlds, f gets the matching arrays of each.
+    template <class F, class... Self>
+    static void for_each_state(F&& f, Self&... s) {
+        f(s.pos...); f(s.vel...); f(s.mass...); f(s.shape_type...); f(s.sphere_radius...); f(s.box_half_extents...);
+        f(s.friction...); f(s.restitution...); f(s.filter...); f(s.gen...); f(s.alive...); f(s.awake...);
+        f(s.sleep_timer...); f(s.sleep_next...);
+        f(s.free_list...); f(s.alive_list...); f(s.alive_slot...); f(s.awake_list...); f(s.awake_slot...);
+        f(s.aabbs...);
+    }
+
+    // Whether restored arrays describe a world step() can run on: per-slot
+    // arrays agree on the slot count, the dense lists and their slot maps
+    // mirror alive/awake, free slots are free and listed once, and sleep_next
+    // only links sleeping bodies into closed rings.
+    bool state_consistent() const {
+        const size_t n = pos.size();
+        if (n > index_mask) return false;
+        const bool sized = vel.size() == n && mass.size() == n && shape_type.size() == n && sphere_radius.size() == n &&
+                           box_half_extents.size() == n && friction.size() == n && restitution.size() == n &&
+                           filter.size() == n && gen.size() == n && alive.size() == n && awake.size() == n &&
+                           sleep_timer.size() == n && sleep_next.size() == n && alive_slot.size() == n &&
+                           awake_slot.size() == n && aabbs.size() <= n;
+        if (!sized) return false;
+        size_t alive_count = 0, awake_count = 0;
+        for (size_t i = 0; i < n; ++i) {
+            if (alive[i] > 1 || awake[i] > 1 || gen[i] > generation_mask) return false;
+            if (shape_type[i] > static_cast<uint8_t>(ShapeType::Box)) return false;
+            if (awake[i] && (!alive[i] || mass[i] <= 0.0f)) return false;
+            alive_count += alive[i];
+            awake_count += awake[i];
+        }
+        auto mirrors = [&](const std::vector<uint32_t>& list, const std::vector<uint32_t>& slot,
+                           const std::vector<uint8_t>& flag, size_t count) {
+            if (list.size() != count) return false;
+            for (size_t k = 0; k < list.size(); ++k) {
+                if (list[k] >= n || !flag[list[k]] || slot[list[k]] != k) return false;
+            }
+            for (size_t i = 0; i < n; ++i) {
+                if ((slot[i] == npos) == (flag[i] != 0)) return false;
+            }
+            return true;
+        };
+        if (!mirrors(alive_list, alive_slot, alive, alive_count)) return false;
+        if (!mirrors(awake_list, awake_slot, awake, awake_count)) return false;
+        std::vector<uint8_t> seen(n, 0);
+        for (uint32_t i : free_list) {
+            if (i >= n || alive[i] || seen[i]) return false;
+            seen[i] = 1;
+        }
+        // Each linked body has exactly one predecessor, so the links form rings
+        std::fill(seen.begin(), seen.end(), uint8_t{0});
+        for (size_t i = 0; i < n; ++i) {
+            const uint32_t next = sleep_next[i];
+            if (next == npos) continue;
+            if (!alive[i] || awake[i] || mass[i] <= 0.0f) return false;
+            if (next >= n || sleep_next[next] == npos || seen[next]) return false;
+            seen[next] = 1;
+        }
+        return true;
+    }
+};
+
+// Contact solver state shared by the island jobs. Only velocities of
+// finite-mass bodies are written, so disjoint contact lists (islands) can be
+// solved concurrently even when they share a static body.
+namespace {
+struct SolverView {
+    Vec3* vel;
+    const float* mass;
+    const uint8_t* alive;
+    const Contact* contacts;
+    float* impulses_n;
+    Vec3* impulses_t;
+};
+}
+
+static constexpr int solver_iterations = 8;
+static constexpr float baumgarte = 0.2f; // positional error correction factor
+
+// Apply the accumulated (warm-start) impulse of contact i to velocities
+static inline void warm_start_contact(const SolverView& s, uint32_t i) {
+    const Contact &c = s.contacts[i];
+    const float Jn = s.impulses_n[i];
+    const Vec3 Jt = s.impulses_t[i];
+    if (Jn == 0.0f && Jt.x == 0.0f && Jt.y == 0.0f && Jt.z == 0.0f) return;
+    const float invMa = (s.mass[c.a] > 0.0f) ? (1.0f / s.mass[c.a]) : 0.0f;
+    const float invMb = (s.mass[c.b] > 0.0f) ? (1.0f / s.mass[c.b]) : 0.0f;
+    Vec3 va = s.vel[c.a];
+    Vec3 vb = s.vel[c.b];
+    // Normal impulse
+    va.x -= c.nx * (Jn * invMa); va.y -= c.ny * (Jn * invMa); va.z -= c.nz * (Jn * invMa);
+    vb.x += c.nx * (Jn * invMb); vb.y += c.ny * (Jn * invMb); vb.z += c.nz * (Jn * invMb);
+    // Tangent impulse
+    va.x -= Jt.x * invMa; va.y -= Jt.y * invMa; va.z -= Jt.z * invMa;
+    vb.x += Jt.x * invMb; vb.y += Jt.y * invMb; vb.z += Jt.z * invMb;
+    if (invMa > 0.0f) s.vel[c.a] = va;
+    if (invMb > 0.0f) s.vel[c.b] = vb;
+}
+
+// One projected Gauss-Seidel update of contact i (restitution only on the first iteration)
+static inline void solve_contact(const SolverView& s, uint32_t i, float dt, bool first_iter) {
+    const Contact &c = s.contacts[i];
+    const uint32_t ia = c.a, ib = c.b;
+    if (!s.alive[ia] || !s.alive[ib]) return;
+    const float invMa = (s.mass[ia] > 0.0f) ? (1.0f / s.mass[ia]) : 0.0f;
+    const float invMb = (s.mass[ib] > 0.0f) ? (1.0f / s.mass[ib]) : 0.0f;
+    if (invMa == 0.0f && invMb == 0.0f) return;
+    Vec3 va = s.vel[ia];
+    Vec3 vb = s.vel[ib];
+    const float rvx = vb.x - va.x;
+    const float rvy = vb.y - va.y;
+    const float rvz = vb.z - va.z;
+    const float vn = rvx * c.nx + rvy * c.ny + rvz * c.nz;
+    const float k_n = invMa + invMb;
+    if (k_n <= 0.0f) return;
+
+    // Normal impulse with restitution and Baumgarte bias
+    float bias = baumgarte * (c.penetration / dt);
+    // Apply restitution only on first iteration and if separating velocity is significant
+    if (first_iter && c.restitution > 0.0f && vn < -0.1f) {
+        bias -= c.restitution * vn;
+    }
+    float deltaJn = -(vn + bias) / k_n;
+    float Jn = s.impulses_n[i];
+    float Jn_new = Jn + deltaJn;
+    if (Jn_new < 0.0f) Jn_new = 0.0f;
+    deltaJn = Jn_new - Jn;
+    if (deltaJn != 0.0f) {
+        va.x -= c.nx * (deltaJn * invMa); va.y -= c.ny * (deltaJn * invMa); va.z -= c.nz * (deltaJn * invMa);
+        vb.x += c.nx * (deltaJn * invMb); vb.y += c.ny * (deltaJn * invMb); vb.z += c.nz * (deltaJn * invMb);
+        s.impulses_n[i] = Jn_new;
+        Jn = Jn_new;
+    }
+
+    // Friction impulse (tangential), from the post-normal-impulse relative velocity
+    if (c.friction > 0.0f) {
+        const float rvx2 = vb.x - va.x;
+        const float rvy2 = vb.y - va.y;
+        const float rvz2 = vb.z - va.z;
+        const float vn2 = rvx2 * c.nx + rvy2 * c.ny + rvz2 * c.nz;
+        const float rvx_t = rvx2 - vn2 * c.nx;
+        const float rvy_t = rvy2 - vn2 * c.ny;
+        const float rvz_t = rvz2 - vn2 * c.nz;
+        const float vt_mag = std::sqrt(rvx_t*rvx_t + rvy_t*rvy_t + rvz_t*rvz_t);
+        if (vt_mag > 1e-6f) {
+            const float tx = rvx_t / vt_mag;
+            const float ty = rvy_t / vt_mag;
+            const float tz = rvz_t / vt_mag;
+            const float vt = vt_mag;
+            float deltaJt_mag = -vt / k_n;
+            Vec3 Jt = s.impulses_t[i];
+            const float Jt_old_mag = std::sqrt(Jt.x*Jt.x + Jt.y*Jt.y + Jt.z*Jt.z);
+            const float Jt_new_mag = Jt_old_mag + deltaJt_mag;
+            const float maxFriction = c.friction * Jn;
+            float Jt_clamped = Jt_new_mag;
+            if (Jt_clamped > maxFriction) Jt_clamped = maxFriction;
+            if (Jt_clamped < -maxFriction) Jt_clamped = -maxFriction;
+            deltaJt_mag = Jt_clamped - Jt_old_mag;
+            if (std::abs(deltaJt_mag) > 1e-9f) {
+                const float deltaJtx = tx * deltaJt_mag;
+                const float deltaJty = ty * deltaJt_mag;
+                const float deltaJtz = tz * deltaJt_mag;
+                va.x -= deltaJtx * invMa; va.y -= deltaJty * invMa; va.z -= deltaJtz * invMa;
+                vb.x += deltaJtx * invMb; vb.y += deltaJty * invMb; vb.z += deltaJtz * invMb;
+                Jt.x += deltaJtx; Jt.y += deltaJty; Jt.z += deltaJtz;
+                s.impulses_t[i] = Jt;
+            }
+        }
+    }
+    if (invMa > 0.0f) s.vel[ia] = va;
+    if (invMb > 0.0f) s.vel[ib] = vb;
+}
+
+static void warm_start_contacts(const SolverView& s, const uint32_t* order, size_t count) {
+    for (size_t k = 0; k < count; ++k) warm_start_contact(s, order[k]);
+}
+
+// Projected Gauss-Seidel over the listed contacts, in list order
+static void solve_contacts(const SolverView& s, const uint32_t* order, size_t count, float dt) {
+    for (int iter = 0; iter < solver_iterations; ++iter) {
+        for (size_t k = 0; k < count; ++k) solve_contact(s, order[k], dt, iter == 0);
+    }
+}
+
+// Contacts per job within a color batch
+static constexpr std::size_t color_grain = 128;
+
+// Warm start and PGS over color batches: batches run in color order and the
+// contacts of an independent batch are split across the job system. Contacts of
+// a batch share no finite-mass body, so the result does not depend on the
+// thread count and equals solving the batches one after another.
+static void solve_colored(JobSystem* jobs, const SolverView& s, const ContactColoring& coloring, float dt) {
+    const size_t batches = coloring.batchCount();
+    for (size_t k = 0; k < batches; ++k) {
+        const auto list = coloring.batch(k);
+        if (!coloring.independent(k)) { warm_start_contacts(s, list.data(), list.size()); continue; }
+        for_range(jobs, list.size(), color_grain, [&](size_t begin, size_t end) {
+            warm_start_contacts(s, list.data() + begin, end - begin);
+        });
+    }
+    if (dt <= 0.0f) return;
+    for (int iter = 0; iter < solver_iterations; ++iter) {
+        const bool first_iter = iter == 0;
+        for (size_t k = 0; k < batches; ++k) {
+            const auto list = coloring.batch(k);
+            if (!coloring.independent(k)) {
+                for (uint32_t i : list) solve_contact(s, i, dt, first_iter);
+                continue;
+            }
+            for_range(jobs, list.size(), color_grain, [&](size_t begin, size_t end) {
+                for (size_t j = begin; j < end; ++j) solve_contact(s, list[j], dt, first_iter);
+            });
+        }
+    }
+}
+
+// Snapshot layout: header, then each state array as [u64 count][elements]
+// padded to 8 bytes (Impl::for_each_state order), then the warm-start table.
+namespace {
+struct SnapshotHeader {
+    uint32_t magic;
+    uint32_t version;
+    uint32_t index_bits;
+    uint32_t cache_stamp;
+    uint64_t cache_size;
+    uint64_t total_bytes;
 };
+constexpr uint32_t snapshot_magic = 0x53455041u; // "APES"
+constexpr uint32_t snapshot_version = 3; // 2: collision filters, 3: sleep rings
 
-World::World() : impl(new Impl) {}
+size_t pad8(size_t n) { return (n + 7) & ~size_t{7}; }
+
+template <class T>
+size_t block_bytes(size_t count) { return sizeof(uint64_t) + pad8(count * sizeof(T)); }
+
+// Writes [count][data][zero padding] at dst, returns the bytes written
+template <class T>
+size_t put_block(std::byte* dst, const T* data, size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    const uint64_t n = count;
+    std::memcpy(dst, &n, sizeof(n));
+    const size_t bytes = count * sizeof(T);
+    if (bytes) std::memcpy(dst + sizeof(n), data, bytes);
+    std::memset(dst + sizeof(n) + bytes, 0, pad8(bytes) - bytes);
+    return sizeof(n) + pad8(bytes);
+}
+
+// Element count of the block at src, or SIZE_MAX if it runs past end
+template <class T>
+size_t block_count(const std::byte* src, const std::byte* end) {
+    if (end - src < static_cast<std::ptrdiff_t>(sizeof(uint64_t))) return SIZE_MAX;
+    uint64_t n;
+    std::memcpy(&n, src, sizeof(n));
+    const size_t room = static_cast<size_t>(end - src) - sizeof(uint64_t);
+    if (n > room / sizeof(T) || pad8(static_cast<size_t>(n) * sizeof(T)) > room) return SIZE_MAX;
+    return static_cast<size_t>(n);
+}
+}
+
+World::World() : World(WorldDesc{}) {}
+World::World(const WorldDesc& desc) : impl(new Impl(desc)) {}
 World::~World() { delete impl; }
 
 std::uint32_t World::createRigidBody(const RigidBodyDesc& d) {
-    uint16_t idx;
+    uint32_t idx;
     if (!impl->free_list.empty()) {
+        // reuse slot; generation stays as is for valid new handle
         idx = impl->free_list.back();
         impl->free_list.pop_back();
-        // reuse slot; generation stays as is for valid new handle
-        if (idx >= impl->pos.size()) {
-            // should not happen; defensive
-            idx = static_cast<uint16_t>(impl->pos.size());
-            impl->pos.push_back(d.position);
-            impl->vel.push_back(d.velocity);
-            impl->mass.push_back(d.mass);
-            impl->shape_type.push_back(static_cast<uint8_t>(d.shape_type));
-            impl->sphere_radius.push_back(d.sphere_radius > 0.0f ? d.sphere_radius : 0.5f);
-            impl->box_half_extents.push_back(d.box_half_extents);
-            impl->friction.push_back(d.friction);
-            impl->restitution.push_back(d.restitution);
-            impl->gen.push_back(0);
-            impl->alive.push_back(1);
-            impl->awake.push_back(1); // start awake
-            impl->sleep_timer.push_back(0.0f);
-            return Impl::pack_handle(idx, impl->gen[idx]);
-        }
-        impl->pos[idx] = d.position;
-        impl->vel[idx] = d.velocity;
-        impl->mass[idx] = d.mass;
-        // ensure vectors are large enough
-        if (idx >= impl->shape_type.size()) impl->shape_type.resize(idx+1, static_cast<uint8_t>(ShapeType::Sphere));
-        impl->shape_type[idx] = static_cast<uint8_t>(d.shape_type);
-        if (idx >= impl->sphere_radius.size()) impl->sphere_radius.resize(idx+1, 0.5f);
-        impl->sphere_radius[idx] = d.sphere_radius > 0.0f ? d.sphere_radius : 0.5f;
-        if (idx >= impl->box_half_extents.size()) impl->box_half_extents.resize(idx+1, Vec3{0.5f,0.5f,0.5f});
-        impl->box_half_extents[idx] = d.box_half_extents;
-        if (idx >= impl->friction.size()) impl->friction.resize(idx+1, 0.5f);
-        impl->friction[idx] = d.friction;
-        if (idx >= impl->restitution.size()) impl->restitution.resize(idx+1, 0.0f);
-        impl->restitution[idx] = d.restitution;
-        if (idx >= impl->awake.size()) impl->awake.resize(idx+1, 1);
-        impl->awake[idx] = 1; // start awake
-        if (idx >= impl->sleep_timer.size()) impl->sleep_timer.resize(idx+1, 0.0f);
-        impl->sleep_timer[idx] = 0.0f;
-        impl->alive[idx] = 1;
     } else {
-        if (impl->pos.size() >= std::numeric_limits<uint16_t>::max()) {
+        if (impl->pos.size() >= impl->index_mask) {
             // Out of indices; return invalid handle
             return std::numeric_limits<uint32_t>::max();
         }
-        idx = static_cast<uint16_t>(impl->pos.size());
-        impl->pos.push_back(d.position);
-        impl->vel.push_back(d.velocity);
-        impl->mass.push_back(d.mass);
-        impl->shape_type.push_back(static_cast<uint8_t>(d.shape_type));
-        impl->sphere_radius.push_back(d.sphere_radius > 0.0f ? d.sphere_radius : 0.5f);
-        impl->box_half_extents.push_back(d.box_half_extents);
-        impl->friction.push_back(d.friction);
-        impl->restitution.push_back(d.restitution);
-        impl->gen.push_back(0);
-        impl->alive.push_back(1);
-        impl->awake.push_back(1); // start awake
-        impl->sleep_timer.push_back(0.0f);
-    }
-    return Impl::pack_handle(idx, impl->gen[idx]);
+        idx = static_cast<uint32_t>(impl->pos.size());
+        impl->grow(idx + 1);
+    }
+    return impl->init_body(idx, d);
+}
+
+std::size_t World::createRigidBodies(std::span<const RigidBodyDesc> descs, std::span<std::uint32_t> out) {
+    const size_t count = std::min(descs.size(), out.size());
+    // Same slots as repeated createRigidBody: free list first (LIFO), then new
+    // slots, which are added with one resize per array
+    const size_t reused = std::min(count, impl->free_list.size());
+    const size_t first = impl->pos.size();
+    const size_t fresh = std::min(count - reused, impl->index_mask - first);
+    impl->grow(first + fresh);
+    impl->alive_list.reserve(impl->alive_list.size() + reused + fresh);
+    impl->awake_list.reserve(impl->awake_list.size() + reused + fresh);
+    for (size_t i = 0; i < count; ++i) {
+        if (i < reused) {
+            const uint32_t idx = impl->free_list.back();
+            impl->free_list.pop_back();
+            out[i] = impl->init_body(idx, descs[i]);
+        } else if (i < reused + fresh) {
+            out[i] = impl->init_body(static_cast<uint32_t>(first + (i - reused)), descs[i]);
+        } else {
+            out[i] = std::numeric_limits<uint32_t>::max();
+        }
+    }
+    return reused + fresh;
+}
+
+void World::destroyRigidBodies(std::span<const std::uint32_t> ids) {
+    for (std::uint32_t id : ids) destroyRigidBody(id);
+}
+
+void World::reserve(std::size_t capacity) {
+    impl->reserve(std::min<size_t>(capacity, impl->index_mask));
 }
 
 void World::destroyRigidBody(std::uint32_t id) {
-    const uint16_t idx = Impl::handle_index(id);
-    const uint16_t g = Impl::handle_generation(id);
+    const uint32_t idx = impl->handle_index(id);
+    const uint32_t g = impl->handle_generation(id);
     if (idx >= impl->pos.size()) return;
     if (!impl->alive[idx]) return;
     if (impl->gen[idx] != g) return;
+    // A sleeping body leaves its ring; the rest of its island wakes up, since
+    // it may have been resting on this one
+    if (impl->sleep_next[idx] != Impl::npos) {
+        const uint32_t next = impl->sleep_next[idx];
+        uint32_t prev = next;
+        while (impl->sleep_next[prev] != idx) prev = impl->sleep_next[prev];
+        impl->sleep_next[prev] = next;
+        impl->sleep_next[idx] = Impl::npos;
+        if (next != idx) impl->wake(next);
+    }
     impl->alive[idx] = 0;
+    if (impl->is_static(idx)) impl->wake_touching(impl->body_aabb(idx));
+    impl->remove_inactive(idx);
+    impl->set_asleep(idx);
+    Impl::list_remove(impl->alive_list, impl->alive_slot, idx);
+    // The broadphase keeps seeing the slot until it is reused; make it empty
+    if (idx < impl->aabbs.size()) impl->aabbs[idx] = aabb_empty();
     // Bump generation to invalidate outstanding handles
-    impl->gen[idx] = static_cast<uint16_t>(impl->gen[idx] + 1);
+    impl->gen[idx] = (impl->gen[idx] + 1) & impl->generation_mask;
     impl->free_list.push_back(idx);
 }
 
 void World::step(float dt) {
     const Vec3 g = impl->gravity;
     const size_t n = impl->pos.size();
+    JobSystem* jobs = impl->jobs;
+    // Stages run in dependency order; each per-body/per-pair stage is split into
+    // independent chunks that only write their own slots.
+    // Per-body stages walk the dense awake list: sleeping bodies neither move
+    // nor change velocity, and destroyed slots are never visited.
+    const uint32_t* awake_list = impl->awake_list.data();
+    const size_t awake_count = impl->awake_list.size();
+    APE_STATS(
+        StageClock clock;
+        StepStats& st = impl->stats;
+        st = StepStats{};
+        st.bodies = static_cast<uint32_t>(impl->alive_list.size());
+        st.awake_bodies = static_cast<uint32_t>(awake_count);
+        const size_t buffer_bytes = impl->step_buffer_bytes();
+    )
+    // Scratch of the previous step is dead; regrows here (once) if it spilled
+    impl->frame_arena.reset();
     // 1) Integrate velocities with gravity (skip sleeping bodies)
-    for (size_t i = 0; i < n; ++i) {
-        if (!impl->alive[i] || !impl->awake[i]) continue;
-        Vec3 v = impl->vel[i];
-        v.x += g.x * dt; v.y += g.y * dt; v.z += g.z * dt;
-        impl->vel[i] = v;
-    }
-
-    // 2) Broadphase on current positions (include sleeping for wake-on-contact)
-    impl->aabbs.clear();
-    impl->aabbs.reserve(n);
-    for (size_t i = 0; i < n; ++i) {
-        if (!impl->alive[i]) { impl->aabbs.push_back(AABB{0,0,0,0,0,0}); continue; }
-        // Include sleeping bodies in broadphase to wake them on contact
-        const Vec3 p = impl->pos[i];
-        const ShapeType stype = (i < impl->shape_type.size()) ? static_cast<ShapeType>(impl->shape_type[i]) : ShapeType::Sphere;
-        AABB box{};
-        if (stype == ShapeType::Box) {
-            const Vec3 h = (i < impl->box_half_extents.size()) ? impl->box_half_extents[i] : Vec3{0.5f,0.5f,0.5f};
-            box = AABB{p.x - h.x, p.y - h.y, p.z - h.z, p.x + h.x, p.y + h.y, p.z + h.z};
-        } else {
-            // Sphere
-            const float r = (i < impl->sphere_radius.size() && impl->sphere_radius[i] > 0.0f) ? impl->sphere_radius[i] : 0.5f;
-            box = AABB{p.x - r, p.y - r, p.z - r, p.x + r, p.y + r, p.z + r};
+    for_range(jobs, awake_count, body_grain, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            const uint32_t i = awake_list[k];
+            Vec3 v = impl->vel[i];
+            v.x += g.x * dt; v.y += g.y * dt; v.z += g.z * dt;
+            impl->vel[i] = v;
+        }
+    });
+    APE_STATS(st.integrate_ms += clock.lap();)
+
+    // 2) Broadphase over awake boxes. Sleeping and static bodies hold
+    // aabb_empty() here (as do destroyed slots); their boxes are in the
+    // inactive trees, queried below.
+    impl->aabbs.resize(n, aabb_empty());
+    for_range(jobs, awake_count, body_grain, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            const uint32_t i = awake_list[k];
+            impl->aabbs[i] = impl->body_aabb(i);
+        }
+    });
+    // Collision filters are applied inside the backends, so filtered pairs
+    // are never emitted
+    const CollisionFilter* filters = impl->filters();
+    switch (impl->broadphase_type) {
+    case BroadphaseType::DynamicTree:
+        impl->tree_bp.update(impl->aabbs.data(), impl->aabbs.size(), impl->pairs, filters);
+        break;
+    case BroadphaseType::SpatialGrid:
+        impl->grid_bp.update(impl->aabbs.data(), impl->aabbs.size(), impl->pairs, filters);
+        break;
+    case BroadphaseType::Regions:
+        impl->region_bp.update(impl->aabbs.data(), impl->aabbs.size(), impl->pairs, jobs, filters);
+        break;
+    case BroadphaseType::SweepAndPrune:
+    default:
+        impl->sap.update(impl->aabbs.data(), impl->aabbs.size(), impl->pairs, filters);
+        break;
+    }
+    // Awake-vs-inactive pairs: every awake box against both inactive trees,
+    // merged into the same (a, b) order. Inactive-inactive pairs (resting
+    // piles, floors) are never formed.
+    if (impl->static_tree.proxyCount() + impl->sleep_tree.proxyCount() > 0 && awake_count > 0) {
+        const size_t chunks = (awake_count + body_grain - 1) / body_grain;
+        if (impl->inactive_pair_chunks.size() < chunks) impl->inactive_pair_chunks.resize(chunks);
+        auto query_chunk = [&](size_t begin, size_t end) {
+            std::vector<Pair>& out = impl->inactive_pair_chunks[begin / body_grain];
+            out.clear();
+            for (size_t k = begin; k < end; ++k) {
+                const uint32_t d = awake_list[k];
+                auto add = [&](uint32_t in_idx) {
+                    if (filters && !filters_collide(filters[d], filters[in_idx])) return;
+                    out.push_back(d < in_idx ? Pair{d, in_idx} : Pair{in_idx, d});
+                };
+                impl->static_tree.query(impl->aabbs[d], add);
+                impl->sleep_tree.query(impl->aabbs[d], add);
+            }
+        };
+        if (jobs && chunks > 1) jobs->parallel_for(awake_count, body_grain, query_chunk);
+        else for (size_t b = 0; b < awake_count; b += body_grain) query_chunk(b, std::min(awake_count, b + body_grain));
+        impl->inactive_pairs.clear();
+        for (size_t c = 0; c < chunks; ++c) {
+            const auto& chunk = impl->inactive_pair_chunks[c];
+            impl->inactive_pairs.insert(impl->inactive_pairs.end(), chunk.begin(), chunk.end());
+        }
+        if (!impl->inactive_pairs.empty()) {
+            std::sort(impl->inactive_pairs.begin(), impl->inactive_pairs.end(), pair_less);
+            impl->merged_pairs.resize(impl->pairs.size() + impl->inactive_pairs.size());
+            std::merge(impl->pairs.begin(), impl->pairs.end(), impl->inactive_pairs.begin(), impl->inactive_pairs.end(),
+                       impl->merged_pairs.begin(), pair_less);
+            impl->pairs.swap(impl->merged_pairs);
         }
-        impl->aabbs.push_back(box);
     }
-    impl->pairs.clear();
-    broadphase_sweep_1d(impl->aabbs.data(), impl->aabbs.size(), impl->pairs, 0);
     impl->last_pair_count = static_cast<uint32_t>(impl->pairs.size());
+    APE_STATS(st.broadphase_ms = clock.lap();)
 
     // 3) Narrowphase contacts
     impl->contacts.clear();
@@ -174,143 +765,120 @@ void World::step(float dt) {
     const Vec3* box_half_extents_ptr = impl->box_half_extents.empty() ? nullptr : impl->box_half_extents.data();
     const float* friction_ptr = impl->friction.empty() ? nullptr : impl->friction.data();
     const float* restitution_ptr = impl->restitution.empty() ? nullptr : impl->restitution.data();
-    generate_contacts(impl->pos.data(), shape_types_ptr, sphere_radii_ptr, box_half_extents_ptr, 
-                     friction_ptr, restitution_ptr, impl->pos.size(), impl->pairs, impl->contacts);
+    const size_t pair_count = impl->pairs.size();
+    if (jobs && pair_count > pair_grain) {
+        // Each chunk writes its own buffer; concatenating in chunk order keeps
+        // the contact order identical to the single-threaded path, which walks
+        // the same pair_grain chunks (contacts are grouped by shape per chunk).
+        const size_t chunks = (pair_count + pair_grain - 1) / pair_grain;
+        if (impl->contact_chunks.size() < chunks) impl->contact_chunks.resize(chunks);
+        jobs->parallel_for(pair_count, pair_grain, [&](size_t begin, size_t end) {
+            std::vector<Contact>& out = impl->contact_chunks[begin / pair_grain];
+            out.clear();
+            generate_contacts(impl->pos.data(), shape_types_ptr, sphere_radii_ptr, box_half_extents_ptr,
+                              friction_ptr, restitution_ptr, n, impl->pairs.data() + begin, end - begin, out);
+        });
+        for (size_t c = 0; c < chunks; ++c) {
+            impl->contacts.insert(impl->contacts.end(), impl->contact_chunks[c].begin(), impl->contact_chunks[c].end());
+        }
+    } else {
+        for (size_t begin = 0; begin < pair_count; begin += pair_grain) {
+            const size_t end = std::min(pair_count, begin + pair_grain);
+            generate_contacts(impl->pos.data(), shape_types_ptr, sphere_radii_ptr, box_half_extents_ptr,
+                              friction_ptr, restitution_ptr, n, impl->pairs.data() + begin, end - begin, impl->contacts);
+        }
+    }
+
+    APE_STATS(st.narrowphase_ms = clock.lap();)
 
-    // Wake sleeping bodies on contact with awake bodies
+    // Wake: sleeping bodies only ever touch awake ones, so each one in a
+    // contact wakes, together with the island it fell asleep with
     for (const Contact &c : impl->contacts) {
-        const uint32_t ia = c.a, ib = c.b;
-        if (ia >= impl->awake.size() || ib >= impl->awake.size()) continue;
-        const bool awake_a = impl->awake[ia] != 0;
-        const bool awake_b = impl->awake[ib] != 0;
-        if (awake_a && !awake_b) {
-            impl->awake[ib] = 1;
-            impl->sleep_timer[ib] = 0.0f;
-        } else if (awake_b && !awake_a) {
-            impl->awake[ia] = 1;
-            impl->sleep_timer[ia] = 0.0f;
-        }
+        impl->wake(c.a);
+        impl->wake(c.b);
     }
+    // Islands over the contact graph, built over the awake list only
+    impl->islands.build(n, impl->awake_list, impl->mass.data(), impl->contacts.data(), impl->contacts.size());
+    const size_t island_count = impl->islands.islandCount();
+    impl->island_sleeps = impl->frame_arena.alloc<uint8_t>(island_count, 0);
+    APE_STATS(st.islands_ms = clock.lap();)
 
     // 4) PGS solver with friction, restitution, warm-start
-    const int solverIterations = 8;
-    const float baumgarte = 0.2f; // positional error correction factor
-
-    // Initialize current impulses and warm-start
-    impl->solver_impulses_n.assign(impl->contacts.size(), 0.0f);
-    impl->solver_impulses_t.assign(impl->contacts.size(), Vec3{0,0,0});
-    if (!impl->warm_pairs.empty() && !impl->warm_impulses_n.empty()) {
+    // Initialize current impulses from the warm-start cache
+    impl->solver_impulses_n = impl->frame_arena.alloc<float>(impl->contacts.size(), 0.0f);
+    impl->solver_impulses_t = impl->frame_arena.alloc<Vec3>(impl->contacts.size(), Vec3{0,0,0});
+    if (impl->warm_cache.size() > 0) {
         for (size_t i = 0; i < impl->contacts.size(); ++i) {
-            const Pair key{impl->contacts[i].a, impl->contacts[i].b};
-            for (size_t j = 0; j < impl->warm_pairs.size(); ++j) {
-                if (impl->warm_pairs[j].a == key.a && impl->warm_pairs[j].b == key.b) {
-                    const float Jn = impl->warm_impulses_n[j];
-                    const Vec3 Jt = impl->warm_impulses_t[j];
-                    impl->solver_impulses_n[i] = Jn;
-                    impl->solver_impulses_t[i] = Jt;
-                    // Apply warm-start impulses to velocities
-                    const float invMa = (impl->mass[key.a] > 0.0f) ? (1.0f / impl->mass[key.a]) : 0.0f;
-                    const float invMb = (impl->mass[key.b] > 0.0f) ? (1.0f / impl->mass[key.b]) : 0.0f;
-                    Vec3 va = impl->vel[key.a];
-                    Vec3 vb = impl->vel[key.b];
-                    const Contact &c = impl->contacts[i];
-                    // Normal impulse
-                    va.x -= c.nx * (Jn * invMa); va.y -= c.ny * (Jn * invMa); va.z -= c.nz * (Jn * invMa);
-                    vb.x += c.nx * (Jn * invMb); vb.y += c.ny * (Jn * invMb); vb.z += c.nz * (Jn * invMb);
-                    // Tangent impulse
-                    va.x -= Jt.x * invMa; va.y -= Jt.y * invMa; va.z -= Jt.z * invMa;
-                    vb.x += Jt.x * invMb; vb.y += Jt.y * invMb; vb.z += Jt.z * invMb;
-                    impl->vel[key.a] = va; impl->vel[key.b] = vb;
-                    break;
-                }
-            }
+            const ContactCache::Entry* cached = impl->warm_cache.find(impl->contacts[i].a, impl->contacts[i].b);
+            if (!cached) continue;
+            APE_STATS(++st.warm_start_hits;)
+            impl->solver_impulses_n[i] = cached->normal_impulse;
+            impl->solver_impulses_t[i] = cached->tangent_impulse;
         }
     }
 
-    if (dt > 0.0f) {
-        for (int iter = 0; iter < solverIterations; ++iter) {
-            for (size_t i = 0; i < impl->contacts.size(); ++i) {
-                const Contact &c = impl->contacts[i];
-                const uint32_t ia = c.a, ib = c.b;
-                if (!impl->alive[ia] || !impl->alive[ib]) continue;
-                // Skip if both bodies are sleeping
-                if (!impl->awake[ia] && !impl->awake[ib]) continue;
-                const float invMa = (impl->mass[ia] > 0.0f) ? (1.0f / impl->mass[ia]) : 0.0f;
-                const float invMb = (impl->mass[ib] > 0.0f) ? (1.0f / impl->mass[ib]) : 0.0f;
-                if (invMa == 0.0f && invMb == 0.0f) continue;
-                Vec3 va = impl->vel[ia];
-                Vec3 vb = impl->vel[ib];
-                const float rvx = vb.x - va.x;
-                const float rvy = vb.y - va.y;
-                const float rvz = vb.z - va.z;
-                const float vn = rvx * c.nx + rvy * c.ny + rvz * c.nz;
-                const float k = invMa + invMb;
-                if (k <= 0.0f) continue;
-
-                // Normal impulse with restitution and Baumgarte bias
-                float bias = baumgarte * (c.penetration / dt);
-                // Apply restitution only on first iteration and if separating velocity is significant
-                if (iter == 0 && c.restitution > 0.0f && vn < -0.1f) {
-                    bias -= c.restitution * vn;
-                }
-                float deltaJn = -(vn + bias) / k;
-                float Jn = impl->solver_impulses_n[i];
-                float Jn_new = Jn + deltaJn;
-                if (Jn_new < 0.0f) Jn_new = 0.0f;
-                deltaJn = Jn_new - Jn;
-                if (deltaJn != 0.0f) {
-                    va.x -= c.nx * (deltaJn * invMa); va.y -= c.ny * (deltaJn * invMa); va.z -= c.nz * (deltaJn * invMa);
-                    vb.x += c.nx * (deltaJn * invMb); vb.y += c.ny * (deltaJn * invMb); vb.z += c.nz * (deltaJn * invMb);
-                    impl->vel[ia] = va; impl->vel[ib] = vb;
-                    impl->solver_impulses_n[i] = Jn_new;
-                    Jn = Jn_new;
-                }
-
-                // Friction impulse (tangential)
-                if (c.friction > 0.0f) {
-                    va = impl->vel[ia];
-                    vb = impl->vel[ib];
-                    const float rvx_t = (vb.x - va.x) - vn * c.nx;
-                    const float rvy_t = (vb.y - va.y) - vn * c.ny;
-                    const float rvz_t = (vb.z - va.z) - vn * c.nz;
-                    const float vt_mag = std::sqrt(rvx_t*rvx_t + rvy_t*rvy_t + rvz_t*rvz_t);
-                    if (vt_mag > 1e-6f) {
-                        const float tx = rvx_t / vt_mag;
-                        const float ty = rvy_t / vt_mag;
-                        const float tz = rvz_t / vt_mag;
-                        const float vt = vt_mag;
-                        float deltaJt_mag = -vt / k;
-                        Vec3 Jt = impl->solver_impulses_t[i];
-                        const float Jt_old_mag = std::sqrt(Jt.x*Jt.x + Jt.y*Jt.y + Jt.z*Jt.z);
-                        const float Jt_new_mag = Jt_old_mag + deltaJt_mag;
-                        const float maxFriction = c.friction * Jn;
-                        float Jt_clamped = Jt_new_mag;
-                        if (Jt_clamped > maxFriction) Jt_clamped = maxFriction;
-                        if (Jt_clamped < -maxFriction) Jt_clamped = -maxFriction;
-                        deltaJt_mag = Jt_clamped - Jt_old_mag;
-                        if (std::abs(deltaJt_mag) > 1e-9f) {
-                            const float deltaJtx = tx * deltaJt_mag;
-                            const float deltaJty = ty * deltaJt_mag;
-                            const float deltaJtz = tz * deltaJt_mag;
-                            va.x -= deltaJtx * invMa; va.y -= deltaJty * invMa; va.z -= deltaJtz * invMa;
-                            vb.x += deltaJtx * invMb; vb.y += deltaJty * invMb; vb.z += deltaJtz * invMb;
-                            impl->vel[ia] = va; impl->vel[ib] = vb;
-                            Jt.x += deltaJtx; Jt.y += deltaJty; Jt.z += deltaJtz;
-                            impl->solver_impulses_t[i] = Jt;
-                        }
-                    }
-                }
-            }
+    // Islands that have contacts are solved independently (in parallel when a
+    // job system is attached); sleeping bodies are in no island and cost nothing.
+    {
+        const std::span<uint32_t> solve = impl->frame_arena.alloc<uint32_t>(island_count);
+        size_t count = 0;
+        for (size_t k = 0; k < island_count; ++k) {
+            if (!impl->islands.contacts(k).empty()) solve[count++] = static_cast<uint32_t>(k);
         }
+        impl->solve_islands = solve.first(count);
     }
+    const SolverView sv{impl->vel.data(), impl->mass.data(), impl->alive.data(), impl->contacts.data(),
+                        impl->solver_impulses_n.data(), impl->solver_impulses_t.data()};
+    if (impl->solver_type == SolverType::GraphColored || impl->solver_type == SolverType::Simd) {
+        const std::span<uint32_t> solve = impl->frame_arena.alloc<uint32_t>(impl->contacts.size());
+        size_t count = 0;
+        for (uint32_t k : impl->solve_islands) {
+            const auto list = impl->islands.contacts(k);
+            std::copy(list.begin(), list.end(), solve.begin() + static_cast<std::ptrdiff_t>(count));
+            count += list.size();
+        }
+        impl->solve_list = solve.first(count);
+        impl->coloring.build(n, impl->mass.data(), impl->contacts.data(), impl->solve_list.data(), impl->solve_list.size());
+        if (impl->solver_type == SolverType::Simd) {
+            impl->rows.build(impl->coloring, impl->contacts.data(), impl->mass.data(),
+                             impl->solver_impulses_n.data(), impl->solver_impulses_t.data());
+            impl->rows.warmStart(impl->vel.data(), jobs);
+            impl->rows.solve(impl->vel.data(), dt, solver_iterations, baumgarte, jobs);
+            impl->rows.storeImpulses(impl->solver_impulses_n.data(), impl->solver_impulses_t.data());
+        } else {
+            solve_colored(jobs, sv, impl->coloring, dt);
+        }
+    } else {
+        for_range(jobs, impl->solve_islands.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t k = begin; k < end; ++k) {
+                const auto list = impl->islands.contacts(impl->solve_islands[k]);
+                warm_start_contacts(sv, list.data(), list.size());
+                if (dt > 0.0f) solve_contacts(sv, list.data(), list.size(), dt);
+            }
+        });
+    }
+    APE_STATS(
+        if (dt > 0.0f && !impl->solve_islands.empty()) st.solver_iterations = solver_iterations;
+        for (uint32_t k : impl->solve_islands) {
+            for (uint32_t ci : impl->islands.contacts(k)) {
+                const Contact& c = impl->contacts[ci];
+                const Vec3 va = impl->vel[c.a], vb = impl->vel[c.b];
+                const float vn = (vb.x - va.x) * c.nx + (vb.y - va.y) * c.ny + (vb.z - va.z) * c.nz;
+                st.solver_residual = std::max(st.solver_residual, -vn);
+            }
+        }
+    )
 
     // Optional positional correction (post-solve) to eliminate residual overlap
     if (!impl->contacts.empty()) {
         const float slop = 1e-4f;     // allow tiny overlap to avoid jitter
         const float percent = 0.8f;   // resolve most of the penetration
-        for (const Contact &c : impl->contacts) {
+        for (size_t ci = 0; ci < impl->contacts.size(); ++ci) {
+            const Contact &c = impl->contacts[ci];
             const uint32_t ia = c.a, ib = c.b;
             if (!impl->alive[ia] || !impl->alive[ib]) continue;
+            const uint32_t isl = impl->islands.islandOfContact(ci);
+            if (isl == IslandBuilder::npos) continue;
             Vec3 pa = impl->pos[ia];
             Vec3 pb = impl->pos[ib];
             // Recompute separation along the stored normal
@@ -328,65 +896,87 @@ void World::step(float dt) {
             // We approximate residual using c.penetration when dist hasn't changed much.
             float corr = c.penetration - slop;
             if (corr > 0.0f) {
-                corr *= percent * 0.5f;
-                pa.x -= c.nx * corr; pa.y -= c.ny * corr; pa.z -= c.nz * corr;
-                pb.x += c.nx * corr; pb.y += c.ny * corr; pb.z += c.nz * corr;
-                impl->pos[ia] = pa;
-                impl->pos[ib] = pb;
+                // Split between the bodies; a static body does not move and
+                // the other one takes the whole correction
+                const bool static_a = impl->is_static(ia), static_b = impl->is_static(ib);
+                corr *= percent * ((static_a || static_b) ? 1.0f : 0.5f);
+                if (!static_a) { pa.x -= c.nx * corr; pa.y -= c.ny * corr; pa.z -= c.nz * corr; impl->pos[ia] = pa; }
+                if (!static_b) { pb.x += c.nx * corr; pb.y += c.ny * corr; pb.z += c.nz * corr; impl->pos[ib] = pb; }
             }
         }
     }
 
     // Save warm-start for next frame
-    impl->warm_pairs.clear();
-    impl->warm_impulses_n.clear();
-    impl->warm_impulses_t.clear();
-    impl->warm_pairs.reserve(impl->contacts.size());
-    impl->warm_impulses_n.reserve(impl->contacts.size());
-    impl->warm_impulses_t.reserve(impl->contacts.size());
+    impl->warm_cache.reset(impl->contacts.size());
     for (size_t i = 0; i < impl->contacts.size(); ++i) {
-        impl->warm_pairs.push_back(Pair{impl->contacts[i].a, impl->contacts[i].b});
-        impl->warm_impulses_n.push_back(impl->solver_impulses_n[i]);
-        impl->warm_impulses_t.push_back(impl->solver_impulses_t[i]);
-    }
-
-    // 5) Integrate positions with solved velocities (skip sleeping)
-    for (size_t i = 0; i < n; ++i) {
-        if (!impl->alive[i] || !impl->awake[i]) continue;
-        Vec3 p = impl->pos[i];
-        const Vec3 v = impl->vel[i];
-        p.x += v.x * dt; p.y += v.y * dt; p.z += v.z * dt;
-        impl->pos[i] = p;
-    }
-
-    // 6) Sleep detection: check motion and update timers
-    for (size_t i = 0; i < n; ++i) {
-        if (!impl->alive[i]) continue;
-        if (!impl->awake[i]) continue; // already sleeping
-        
-        // Compute motion: linear velocity magnitude
-        const Vec3 v = impl->vel[i];
-        const float lin_motion = std::sqrt(v.x*v.x + v.y*v.y + v.z*v.z);
-        
-        if (lin_motion < Impl::sleep_linear_threshold) {
-            // Below threshold: accumulate sleep timer
-            impl->sleep_timer[i] += dt;
-            if (impl->sleep_timer[i] >= Impl::sleep_time_required) {
-                // Put to sleep
-                impl->awake[i] = 0;
-                // Zero out velocity to prevent drift
-                impl->vel[i] = Vec3{0,0,0};
+        impl->warm_cache.insert(impl->contacts[i].a, impl->contacts[i].b,
+                                impl->solver_impulses_n[i], impl->solver_impulses_t[i]);
+    }
+    APE_STATS(st.solver_ms = clock.lap();)
+
+    // 5) Integrate positions with solved velocities (skip sleeping). The wake
+    // pass above may have grown the awake list.
+    for_range(jobs, impl->awake_list.size(), body_grain, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            const uint32_t i = impl->awake_list[k];
+            Vec3 p = impl->pos[i];
+            const Vec3 v = impl->vel[i];
+            p.x += v.x * dt; p.y += v.y * dt; p.z += v.z * dt;
+            impl->pos[i] = p;
+        }
+    });
+    APE_STATS(st.integrate_ms += clock.lap();)
+
+    // 6) Sleep detection: per-body timers, then islands sleep as a unit once
+    // every body in them has been slow for long enough
+    for_range(jobs, impl->awake_list.size(), body_grain, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            const uint32_t i = impl->awake_list[k];
+
+            // Compute motion: linear velocity magnitude
+            const Vec3 v = impl->vel[i];
+            const float lin_motion = std::sqrt(v.x*v.x + v.y*v.y + v.z*v.z);
+
+            if (lin_motion < Impl::sleep_linear_threshold) {
+                // Below threshold: accumulate sleep timer
+                impl->sleep_timer[i] += dt;
+            } else {
+                // Above threshold: reset timer
+                impl->sleep_timer[i] = 0.0f;
             }
-        } else {
-            // Above threshold: reset timer
-            impl->sleep_timer[i] = 0.0f;
         }
+    });
+    for_range(jobs, island_count, 64, [&](size_t begin, size_t end) {
+        for (size_t k = begin; k < end; ++k) {
+            const auto bodies = impl->islands.bodies(k);
+            bool ready = true;
+            for (uint32_t b : bodies) {
+                if (impl->sleep_timer[b] < Impl::sleep_time_required) { ready = false; break; }
+            }
+            if (ready) impl->island_sleeps[k] = 1; // falls asleep below
+        }
+    });
+    // List and tree updates are serial; sleeping bodies move to sleep_tree
+    // with their final box, computed once here
+    for (size_t k = 0; k < island_count; ++k) {
+        if (impl->island_sleeps[k]) impl->sleep_island(impl->islands.bodies(k));
     }
+    APE_STATS(
+        st.sleep_ms = clock.lap();
+        st.total_ms = clock.total();
+        st.pairs = impl->last_pair_count;
+        st.contacts = static_cast<uint32_t>(impl->contacts.size());
+        st.islands = static_cast<uint32_t>(island_count);
+        st.solved_islands = static_cast<uint32_t>(impl->solve_islands.size());
+        st.warm_start_hit_rate = st.contacts ? static_cast<float>(st.warm_start_hits) / static_cast<float>(st.contacts) : 0.0f;
+        const size_t bytes_after = impl->step_buffer_bytes();
+        st.buffer_growth_bytes = bytes_after > buffer_bytes ? bytes_after - buffer_bytes : 0;
+    )
 }
 
 Vec3 World::getPosition(std::uint32_t id) const {
-    const uint16_t idx = Impl::handle_index(id);
-    const uint16_t g = Impl::handle_generation(id);
+    const uint32_t idx = impl->handle_index(id);
+    const uint32_t g = impl->handle_generation(id);
     if (idx >= impl->pos.size()) return Vec3{0,0,0};
     if (!impl->alive[idx]) return Vec3{0,0,0};
     if (impl->gen[idx] != g) return Vec3{0,0,0};
@@ -394,32 +984,183 @@ Vec3 World::getPosition(std::uint32_t id) const {
 }
 
 Vec3 World::getVelocity(std::uint32_t id) const {
-    const uint16_t idx = Impl::handle_index(id);
-    const uint16_t g = Impl::handle_generation(id);
+    const uint32_t idx = impl->handle_index(id);
+    const uint32_t g = impl->handle_generation(id);
     if (idx >= impl->vel.size()) return Vec3{0,0,0};
     if (!impl->alive[idx]) return Vec3{0,0,0};
     if (impl->gen[idx] != g) return Vec3{0,0,0};
     return impl->vel[idx];
 }
 
+void World::setPosition(std::uint32_t id, const Vec3& p) {
+    if (!isAlive(id)) return;
+    const uint32_t idx = impl->handle_index(id);
+    if (impl->is_static(idx)) {
+        // Static geometry stays asleep; only its proxy moves. Bodies asleep
+        // against its old or new box wake up.
+        impl->wake_touching(impl->body_aabb(idx));
+        impl->pos[idx] = p;
+        impl->wake_touching(impl->body_aabb(idx));
+        impl->remove_inactive(idx);
+        impl->add_inactive(idx);
+        return;
+    }
+    impl->pos[idx] = p;
+    impl->wake(idx);
+    impl->sleep_timer[idx] = 0.0f;
+}
+
+void World::setVelocity(std::uint32_t id, const Vec3& v) {
+    if (!isAlive(id)) return;
+    const uint32_t idx = impl->handle_index(id);
+    if (impl->is_static(idx)) return;
+    impl->vel[idx] = v;
+    impl->wake(idx);
+    impl->sleep_timer[idx] = 0.0f;
+}
+
+void World::setCollisionFilter(std::uint32_t id, std::uint32_t category, std::uint32_t mask) {
+    if (!isAlive(id)) return;
+    const uint32_t idx = impl->handle_index(id);
+    impl->set_filter(idx, CollisionFilter{category, mask});
+    if (impl->is_static(idx)) return;
+    // A sleeping body may now overlap bodies it used to ignore
+    impl->wake(idx);
+    impl->sleep_timer[idx] = 0.0f;
+}
+
+void World::setJobSystem(JobSystem* jobs) {
+    if (impl->owned_jobs.get() != jobs) impl->owned_jobs.reset();
+    impl->jobs = jobs;
+}
+
+void World::setThreadCount(unsigned threads) {
+    impl->jobs = nullptr;
+    impl->owned_jobs.reset();
+    if (threads > 1) {
+        impl->owned_jobs = std::make_unique<JobSystem>(threads);
+        impl->jobs = impl->owned_jobs.get();
+    }
+}
+
+JobSystem* World::jobSystem() const { return impl->jobs; }
+
+void World::setBroadphase(BroadphaseType type) {
+    if (type == impl->broadphase_type) return;
+    // Release the persistent state of the backend being switched away from
+    impl->sap.clear();
+    impl->tree_bp.clear();
+    impl->grid_bp.clear();
+    impl->region_bp.clear();
+    impl->broadphase_type = type;
+}
+
+BroadphaseType World::broadphase() const { return impl->broadphase_type; }
+
+void World::setSolver(SolverType type) { impl->solver_type = type; }
+SolverType World::solver() const { return impl->solver_type; }
+
 void World::setGravity(const Vec3& g) { impl->gravity = g; }
 Vec3 World::getGravity() const { return impl->gravity; }
 
+std::size_t World::snapshotSize() const {
+    size_t bytes = sizeof(SnapshotHeader);
+    Impl::for_each_state([&](const auto& v) {
+        bytes += block_bytes<typename std::decay_t<decltype(v)>::value_type>(v.size());
+    }, *impl);
+    return bytes + block_bytes<ContactCache::Entry>(impl->warm_cache.slots().size());
+}
+
+std::size_t World::saveSnapshot(std::span<std::byte> out) const {
+    const size_t total = snapshotSize();
+    if (out.size() < total) return 0;
+    const SnapshotHeader h{snapshot_magic, snapshot_version, impl->index_bits, impl->warm_cache.stamp(),
+                           impl->warm_cache.size(), total};
+    std::byte* dst = out.data();
+    std::memcpy(dst, &h, sizeof(h));
+    dst += sizeof(h);
+    Impl::for_each_state([&](const auto& v) { dst += put_block(dst, v.data(), v.size()); }, *impl);
+    const auto cache = impl->warm_cache.slots();
+    put_block(dst, cache.data(), cache.size());
+    return total;
+}
+
+void World::saveSnapshot(WorldSnapshot& out) const {
+    out.bytes.resize(snapshotSize());
+    saveSnapshot(std::span<std::byte>(out.bytes));
+}
+
+bool World::restoreSnapshot(std::span<const std::byte> in) {
+    SnapshotHeader h;
+    if (in.size() < sizeof(h)) return false;
+    std::memcpy(&h, in.data(), sizeof(h));
+    if (h.magic != snapshot_magic || h.version != snapshot_version || h.index_bits != impl->index_bits ||
+        h.total_bytes != in.size()) {
+        return false;
+    }
+    // Read every block into a staging world and check it; the live world is
+    // only touched once all of it passed
+    Impl staged(WorldDesc{impl->index_bits});
+    const std::byte* src = in.data() + sizeof(h);
+    const std::byte* const end = in.data() + in.size();
+    bool ok = true;
+    Impl::for_each_state([&](auto& v) {
+        using T = typename std::decay_t<decltype(v)>::value_type;
+        const size_t n = ok ? block_count<T>(src, end) : SIZE_MAX;
+        if (n == SIZE_MAX) { ok = false; return; }
+        v.resize(n);
+        if (n) std::memcpy(v.data(), src + sizeof(uint64_t), n * sizeof(T));
+        src += block_bytes<T>(n);
+    }, staged);
+    const size_t cache_slots = ok ? block_count<ContactCache::Entry>(src, end) : SIZE_MAX;
+    if (cache_slots == SIZE_MAX || src + block_bytes<ContactCache::Entry>(cache_slots) != end) return false;
+    if (!staged.warm_cache.restore(src + sizeof(uint64_t), cache_slots, h.cache_stamp, static_cast<size_t>(h.cache_size))) {
+        return false;
+    }
+    if (!staged.state_consistent()) return false;
+
+    Impl::for_each_state([](auto& live, auto& fresh) { live.swap(fresh); }, *impl, staged);
+    std::swap(impl->warm_cache, staged.warm_cache);
+    impl->rebuild_inactive();
+    return true;
+}
+
+bool World::restoreSnapshot(const WorldSnapshot& in) {
+    return restoreSnapshot(std::span<const std::byte>(in.bytes));
+}
+
 std::uint32_t World::debug_broadphasePairCount() const { return impl->last_pair_count; }
 
+const StepStats& World::stepStats() const { return impl->stats; }
+bool World::statsEnabled() { return APE_ENABLE_STATS != 0; }
+
 bool World::isAlive(std::uint32_t id) const {
-    const uint16_t idx = Impl::handle_index(id);
-    const uint16_t g = Impl::handle_generation(id);
+    const uint32_t idx = impl->handle_index(id);
+    const uint32_t g = impl->handle_generation(id);
     if (idx >= impl->pos.size()) return false;
     if (!impl->alive[idx]) return false;
     return impl->gen[idx] == g;
 }
 
-std::size_t World::bodyCount() const {
-    std::size_t count = 0;
-    const std::size_t n = impl->alive.size();
-    for (std::size_t i = 0; i < n; ++i) if (impl->alive[i]) ++count;
-    return count;
+bool World::isStatic(std::uint32_t id) const {
+    return isAlive(id) && impl->is_static(impl->handle_index(id));
+}
+
+std::size_t World::bodyCount() const { return impl->alive_list.size(); }
+
+std::size_t World::maxBodies() const { return impl->index_mask; }
+
+BodyView World::bodies() const {
+    return BodyView{impl->pos, impl->vel, impl->alive, impl->awake, impl->alive_list};
+}
+
+std::uint32_t World::slotOf(std::uint32_t id) const {
+    return isAlive(id) ? impl->handle_index(id) : std::numeric_limits<uint32_t>::max();
+}
+
+std::uint32_t World::handleAt(std::uint32_t slot) const {
+    if (slot >= impl->pos.size() || !impl->alive[slot]) return std::numeric_limits<uint32_t>::max();
+    return impl->pack_handle(slot, impl->gen[slot]);
 }
 
 } // namespace ape
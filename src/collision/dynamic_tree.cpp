@@ -0,0 +1,388 @@
+#include "ape/dynamic_tree.h"
+#include <algorithm>
+
+namespace ape
+{
+    namespace
+    {
+        inline AABB aabb_union(const AABB &a, const AABB &b)
+        {
+            return AABB{std::min(a.min_x, b.min_x), std::min(a.min_y, b.min_y), std::min(a.min_z, b.min_z),
+                        std::max(a.max_x, b.max_x), std::max(a.max_y, b.max_y), std::max(a.max_z, b.max_z)};
+        }
+
+        // Half surface area: insertion cost metric (SAH)
+        inline float aabb_cost(const AABB &a)
+        {
+            const float dx = a.max_x - a.min_x;
+            const float dy = a.max_y - a.min_y;
+            const float dz = a.max_z - a.min_z;
+            return dx * dy + dy * dz + dz * dx;
+        }
+
+        inline bool aabb_contains(const AABB &outer, const AABB &inner)
+        {
+            return outer.min_x <= inner.min_x && outer.min_y <= inner.min_y && outer.min_z <= inner.min_z &&
+                   outer.max_x >= inner.max_x && outer.max_y >= inner.max_y && outer.max_z >= inner.max_z;
+        }
+
+        inline bool aabb_is_empty(const AABB &b)
+        {
+            return b.min_x > b.max_x || b.min_y > b.max_y || b.min_z > b.max_z;
+        }
+
+        inline AABB aabb_fatten(const AABB &b, float m)
+        {
+            return AABB{b.min_x - m, b.min_y - m, b.min_z - m, b.max_x + m, b.max_y + m, b.max_z + m};
+        }
+    }
+
+    std::int32_t DynamicTree::allocateNode()
+    {
+        if (free_list_ == null_node)
+        {
+            nodes_.push_back(Node{});
+            nodes_.back().height = -1;
+            free_list_ = static_cast<std::int32_t>(nodes_.size() - 1);
+            nodes_.back().parent = null_node;
+        }
+        const std::int32_t id = free_list_;
+        Node &n = nodes_[static_cast<std::size_t>(id)];
+        free_list_ = n.parent;
+        n.parent = null_node;
+        n.child1 = null_node;
+        n.child2 = null_node;
+        n.height = 0;
+        n.user = 0;
+        return id;
+    }
+
+    void DynamicTree::freeNode(std::int32_t node)
+    {
+        Node &n = nodes_[static_cast<std::size_t>(node)];
+        n.parent = free_list_;
+        n.height = -1;
+        free_list_ = node;
+    }
+
+    void DynamicTree::clear()
+    {
+        nodes_.clear();
+        root_ = null_node;
+        free_list_ = null_node;
+        leaf_count_ = 0;
+    }
+
+    std::int32_t DynamicTree::createProxy(const AABB &box, std::uint32_t user)
+    {
+        const std::int32_t proxy = allocateNode();
+        Node &n = nodes_[static_cast<std::size_t>(proxy)];
+        n.box = aabb_fatten(box, margin_);
+        n.user = user;
+        n.height = 0;
+        insertLeaf(proxy);
+        ++leaf_count_;
+        return proxy;
+    }
+
+    void DynamicTree::destroyProxy(std::int32_t proxy)
+    {
+        removeLeaf(proxy);
+        freeNode(proxy);
+        --leaf_count_;
+    }
+
+    bool DynamicTree::moveProxy(std::int32_t proxy, const AABB &box)
+    {
+        if (aabb_contains(nodes_[static_cast<std::size_t>(proxy)].box, box)) return false;
+        removeLeaf(proxy);
+        nodes_[static_cast<std::size_t>(proxy)].box = aabb_fatten(box, margin_);
+        insertLeaf(proxy);
+        return true;
+    }
+
+    void DynamicTree::insertLeaf(std::int32_t leaf)
+    {
+        if (root_ == null_node)
+        {
+            root_ = leaf;
+            nodes_[static_cast<std::size_t>(leaf)].parent = null_node;
+            return;
+        }
+
+        // Descend choosing the child with the lowest surface-area cost
+        const AABB leaf_box = nodes_[static_cast<std::size_t>(leaf)].box;
+        std::int32_t index = root_;
+        while (nodes_[static_cast<std::size_t>(index)].child1 != null_node)
+        {
+            const Node &node = nodes_[static_cast<std::size_t>(index)];
+            const std::int32_t c1 = node.child1;
+            const std::int32_t c2 = node.child2;
+            const float area = aabb_cost(node.box);
+            const float combined_area = aabb_cost(aabb_union(node.box, leaf_box));
+            // Cost of making a new parent for this node and the leaf
+            const float cost = 2.0f * combined_area;
+            // Minimum cost of pushing the leaf further down
+            const float inheritance = 2.0f * (combined_area - area);
+
+            auto child_cost = [&](std::int32_t c) {
+                const Node &cn = nodes_[static_cast<std::size_t>(c)];
+                const float grown = aabb_cost(aabb_union(leaf_box, cn.box));
+                return (cn.child1 == null_node ? grown : grown - aabb_cost(cn.box)) + inheritance;
+            };
+            const float cost1 = child_cost(c1);
+            const float cost2 = child_cost(c2);
+            if (cost < cost1 && cost < cost2) break;
+            index = (cost1 < cost2) ? c1 : c2;
+        }
+
+        const std::int32_t sibling = index;
+        const std::int32_t old_parent = nodes_[static_cast<std::size_t>(sibling)].parent;
+        const std::int32_t new_parent = allocateNode();
+        {
+            Node &np = nodes_[static_cast<std::size_t>(new_parent)];
+            const Node &sn = nodes_[static_cast<std::size_t>(sibling)];
+            np.parent = old_parent;
+            np.box = aabb_union(leaf_box, sn.box);
+            np.height = sn.height + 1;
+            np.child1 = sibling;
+            np.child2 = leaf;
+        }
+        if (old_parent != null_node)
+        {
+            Node &op = nodes_[static_cast<std::size_t>(old_parent)];
+            if (op.child1 == sibling) op.child1 = new_parent;
+            else op.child2 = new_parent;
+        }
+        else
+        {
+            root_ = new_parent;
+        }
+        nodes_[static_cast<std::size_t>(sibling)].parent = new_parent;
+        nodes_[static_cast<std::size_t>(leaf)].parent = new_parent;
+
+        // Walk back up refitting boxes and rebalancing
+        index = nodes_[static_cast<std::size_t>(leaf)].parent;
+        while (index != null_node)
+        {
+            index = balance(index);
+            Node &n = nodes_[static_cast<std::size_t>(index)];
+            const Node &c1 = nodes_[static_cast<std::size_t>(n.child1)];
+            const Node &c2 = nodes_[static_cast<std::size_t>(n.child2)];
+            n.height = 1 + std::max(c1.height, c2.height);
+            n.box = aabb_union(c1.box, c2.box);
+            index = n.parent;
+        }
+    }
+
+    void DynamicTree::removeLeaf(std::int32_t leaf)
+    {
+        if (leaf == root_)
+        {
+            root_ = null_node;
+            return;
+        }
+        const std::int32_t parent = nodes_[static_cast<std::size_t>(leaf)].parent;
+        const std::int32_t grand_parent = nodes_[static_cast<std::size_t>(parent)].parent;
+        const Node &pn = nodes_[static_cast<std::size_t>(parent)];
+        const std::int32_t sibling = (pn.child1 == leaf) ? pn.child2 : pn.child1;
+
+        if (grand_parent != null_node)
+        {
+            Node &gp = nodes_[static_cast<std::size_t>(grand_parent)];
+            if (gp.child1 == parent) gp.child1 = sibling;
+            else gp.child2 = sibling;
+            nodes_[static_cast<std::size_t>(sibling)].parent = grand_parent;
+            freeNode(parent);
+
+            std::int32_t index = grand_parent;
+            while (index != null_node)
+            {
+                index = balance(index);
+                Node &n = nodes_[static_cast<std::size_t>(index)];
+                const Node &c1 = nodes_[static_cast<std::size_t>(n.child1)];
+                const Node &c2 = nodes_[static_cast<std::size_t>(n.child2)];
+                n.box = aabb_union(c1.box, c2.box);
+                n.height = 1 + std::max(c1.height, c2.height);
+                index = n.parent;
+            }
+        }
+        else
+        {
+            root_ = sibling;
+            nodes_[static_cast<std::size_t>(sibling)].parent = null_node;
+            freeNode(parent);
+        }
+    }
+
+    // Rotate the taller grandchild up if the subtree at `ia` is unbalanced.
+    // Returns the index of the new subtree root.
+    std::int32_t DynamicTree::balance(std::int32_t ia)
+    {
+        Node &A = nodes_[static_cast<std::size_t>(ia)];
+        if (A.child1 == null_node || A.height < 2) return ia;
+
+        const std::int32_t ib = A.child1;
+        const std::int32_t ic = A.child2;
+        Node &B = nodes_[static_cast<std::size_t>(ib)];
+        Node &C = nodes_[static_cast<std::size_t>(ic)];
+        const std::int32_t bal = C.height - B.height;
+
+        auto reparent = [&](std::int32_t new_root, Node &R) {
+            if (R.parent != null_node)
+            {
+                Node &p = nodes_[static_cast<std::size_t>(R.parent)];
+                if (p.child1 == ia) p.child1 = new_root;
+                else p.child2 = new_root;
+            }
+            else
+            {
+                root_ = new_root;
+            }
+        };
+
+        if (bal > 1)
+        {
+            // Rotate C up
+            const std::int32_t iF = C.child1;
+            const std::int32_t iG = C.child2;
+            Node &F = nodes_[static_cast<std::size_t>(iF)];
+            Node &G = nodes_[static_cast<std::size_t>(iG)];
+            C.child1 = ia;
+            C.parent = A.parent;
+            A.parent = ic;
+            reparent(ic, C);
+            if (F.height > G.height)
+            {
+                C.child2 = iF;
+                A.child2 = iG;
+                G.parent = ia;
+                A.box = aabb_union(B.box, G.box);
+                C.box = aabb_union(A.box, F.box);
+                A.height = 1 + std::max(B.height, G.height);
+                C.height = 1 + std::max(A.height, F.height);
+            }
+            else
+            {
+                C.child2 = iG;
+                A.child2 = iF;
+                F.parent = ia;
+                A.box = aabb_union(B.box, F.box);
+                C.box = aabb_union(A.box, G.box);
+                A.height = 1 + std::max(B.height, F.height);
+                C.height = 1 + std::max(A.height, G.height);
+            }
+            return ic;
+        }
+        if (bal < -1)
+        {
+            // Rotate B up
+            const std::int32_t iD = B.child1;
+            const std::int32_t iE = B.child2;
+            Node &D = nodes_[static_cast<std::size_t>(iD)];
+            Node &E = nodes_[static_cast<std::size_t>(iE)];
+            B.child1 = ia;
+            B.parent = A.parent;
+            A.parent = ib;
+            reparent(ib, B);
+            if (D.height > E.height)
+            {
+                B.child2 = iD;
+                A.child1 = iE;
+                E.parent = ia;
+                A.box = aabb_union(C.box, E.box);
+                B.box = aabb_union(A.box, D.box);
+                A.height = 1 + std::max(C.height, E.height);
+                B.height = 1 + std::max(A.height, D.height);
+            }
+            else
+            {
+                B.child2 = iE;
+                A.child1 = iD;
+                D.parent = ia;
+                A.box = aabb_union(C.box, D.box);
+                B.box = aabb_union(A.box, E.box);
+                A.height = 1 + std::max(C.height, D.height);
+                B.height = 1 + std::max(A.height, E.height);
+            }
+            return ib;
+        }
+        return ia;
+    }
+
+    bool DynamicTree::validateNode(std::int32_t index, std::int32_t parent) const
+    {
+        const Node &n = nodes_[static_cast<std::size_t>(index)];
+        if (n.parent != parent) return false;
+        if (n.child1 == null_node) return n.child2 == null_node && n.height == 0;
+        const Node &c1 = nodes_[static_cast<std::size_t>(n.child1)];
+        const Node &c2 = nodes_[static_cast<std::size_t>(n.child2)];
+        if (n.height != 1 + std::max(c1.height, c2.height)) return false;
+        if (c1.height - c2.height > 1 || c2.height - c1.height > 1) return false;
+        if (!aabb_contains(n.box, c1.box) || !aabb_contains(n.box, c2.box)) return false;
+        return validateNode(n.child1, index) && validateNode(n.child2, index);
+    }
+
+    bool DynamicTree::validate() const
+    {
+        if (root_ == null_node) return leaf_count_ == 0;
+        return validateNode(root_, null_node);
+    }
+
+    void DynamicTreeBroadphase::clear()
+    {
+        tree_.clear();
+        proxy_of_.clear();
+    }
+
+    void DynamicTreeBroadphase::update(const AABB *boxes, std::size_t count, std::vector<Pair> &out,
+                                       const CollisionFilter *filters)
+    {
+        out.clear();
+        if (!boxes) count = 0;
+
+        // Drop proxies for indices past the end
+        for (std::size_t i = count; i < proxy_of_.size(); ++i)
+        {
+            if (proxy_of_[i] != DynamicTree::null_node) tree_.destroyProxy(proxy_of_[i]);
+        }
+        proxy_of_.resize(count, DynamicTree::null_node);
+
+        // Sync proxies with the boxes
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            std::int32_t &proxy = proxy_of_[i];
+            if (aabb_is_empty(boxes[i]))
+            {
+                if (proxy != DynamicTree::null_node)
+                {
+                    tree_.destroyProxy(proxy);
+                    proxy = DynamicTree::null_node;
+                }
+            }
+            else if (proxy == DynamicTree::null_node)
+            {
+                proxy = tree_.createProxy(boxes[i], static_cast<std::uint32_t>(i));
+            }
+            else
+            {
+                tree_.moveProxy(proxy, boxes[i]);
+            }
+        }
+
+        // Each index queries with its tight box; keep j > i so every pair is seen once
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            if (proxy_of_[i] == DynamicTree::null_node) continue;
+            const std::uint32_t a = static_cast<std::uint32_t>(i);
+            const AABB &box = boxes[i];
+            const std::size_t first = out.size();
+            tree_.query(box, [&](std::uint32_t j) {
+                if (j <= a || !aabb_overlaps(box, boxes[j])) return;
+                if (filters && !filters_collide(filters[a], filters[j])) return;
+                out.push_back(Pair{a, j});
+            });
+            std::sort(out.begin() + static_cast<std::ptrdiff_t>(first), out.end(), pair_less);
+        }
+    }
+} // namespace ape
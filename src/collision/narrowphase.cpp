@@ -1,5 +1,7 @@
 #include "ape/narrowphase.h"
+#include <bit>
 #include <cmath>
+#include "foundation/simd.h"
 
 namespace ape {
 
@@ -108,43 +110,194 @@ static bool collide_sphere_box(const Vec3& sphere_center, float sphere_radius,
     return false;
 }
 
-// Box-Box collision using SAT (axis-aligned only for now; rotation in future)
-static bool collide_box_box(const Vec3& ca, const Vec3& ha,
-                             const Vec3& cb, const Vec3& hb,
-                             Vec3& normal_out, float& penetration_out) {
-    // Compute overlap on each axis
-    const float dx = std::abs(cb.x - ca.x);
-    const float dy = std::abs(cb.y - ca.y);
-    const float dz = std::abs(cb.z - ca.z);
-    const float overlap_x = (ha.x + hb.x) - dx;
-    const float overlap_y = (ha.y + hb.y) - dy;
-    const float overlap_z = (ha.z + hb.z) - dz;
-    
-    // Check separation on each axis
-    if (overlap_x <= 0.0f || overlap_y <= 0.0f || overlap_z <= 0.0f) {
-        return false; // Separated
+namespace {
+
+// Shape-pair buckets; the bucket of a pair is shape_a + shape_b
+enum Bucket : std::size_t { SphereSphere = 0, SphereBox = 1, BoxBox = 2, BucketCount = 3 };
+static_assert(static_cast<int>(ShapeType::Sphere) == 0 && static_cast<int>(ShapeType::Box) == 1);
+
+// Per-thread scratch so chunked narrowphase jobs do not allocate once warm
+struct Scratch {
+    std::vector<std::uint32_t> list[BucketCount]; // pair positions per bucket
+    std::vector<Contact> contacts;                // compacted kernel output
+};
+thread_local Scratch scratch;
+
+struct Inputs {
+    const Vec3* positions;
+    const std::uint8_t* shape_types;
+    const float* sphere_radii;
+    const Vec3* box_half_extents;
+    const float* frictions;
+    const float* restitutions;
+};
+
+using namespace simd;
+
+// One block of up to W pairs from a bucket list: body indices per lane (the
+// tail is padded with the last pair) and a mask of the real lanes.
+struct Block {
+    alignas(32) std::uint32_t a[W];
+    alignas(32) std::uint32_t b[W];
+    unsigned valid;
+};
+
+inline void load_block(const Pair* pairs, const std::uint32_t* list, std::size_t n, Block& blk) {
+    const std::size_t m = n < W ? n : W;
+    for (std::size_t l = 0; l < W; ++l) {
+        const Pair& p = pairs[list[l < m ? l : m - 1]];
+        blk.a[l] = p.a;
+        blk.b[l] = p.b;
     }
-    
-    // Find axis of minimum penetration
-    float min_overlap = overlap_x;
-    int axis = 0;
-    if (overlap_y < min_overlap) { min_overlap = overlap_y; axis = 1; }
-    if (overlap_z < min_overlap) { min_overlap = overlap_z; axis = 2; }
-    
-    penetration_out = min_overlap;
-    
-    // Normal points from a to b along minimum penetration axis
-    if (axis == 0) {
-        normal_out = Vec3{(cb.x > ca.x) ? 1.0f : -1.0f, 0, 0};
-    } else if (axis == 1) {
-        normal_out = Vec3{0, (cb.y > ca.y) ? 1.0f : -1.0f, 0};
-    } else {
-        normal_out = Vec3{0, 0, (cb.z > ca.z) ? 1.0f : -1.0f};
+    blk.valid = (m == W) ? ((1u << W) - 1u) : ((1u << m) - 1u);
+}
+
+inline vf gather_or(const float* base, const std::uint32_t* idx, float fallback) {
+    return base ? gather1(base, idx) : set1(fallback);
+}
+
+inline void gather_half_extents(const Vec3* base, const std::uint32_t* idx, vf& x, vf& y, vf& z) {
+    if (base) { gather3(base, idx, x, y, z); return; }
+    x = y = z = set1(0.5f);
+}
+
+// Lane results of a block, stored for the compacting write
+struct BlockOut {
+    alignas(32) float nx[W], ny[W], nz[W], pen[W], fr[W], re[W];
+};
+
+// Combined materials: geometric mean friction, min restitution
+inline void materials(const Inputs& in, const Block& blk, BlockOut& o) {
+    const vf fa = gather_or(in.frictions, blk.a, 0.5f);
+    const vf fb = gather_or(in.frictions, blk.b, 0.5f);
+    store(o.fr, sqrt(mul(fa, fb)));
+    const vf ea = gather_or(in.restitutions, blk.a, 0.0f);
+    const vf eb = gather_or(in.restitutions, blk.b, 0.0f);
+    store(o.re, select(lt(ea, eb), ea, eb));
+}
+
+// Compacting store: every lane is written at the cursor, which only advances
+// past hits (the buffer keeps W slots of slack), so no per-lane branch.
+inline std::size_t compact(const Block& blk, const BlockOut& o, unsigned hits, Contact* out, std::size_t w) {
+    for (std::size_t l = 0; l < W; ++l) {
+        out[w] = Contact{blk.a[l], blk.b[l], o.nx[l], o.ny[l], o.nz[l], o.pen[l], o.fr[l], o.re[l]};
+        w += (hits >> l) & 1u;
     }
-    
-    return true;
+    return w;
+}
+
+std::size_t sphere_sphere_bucket(const Inputs& in, const Pair* pairs, const std::uint32_t* list, std::size_t n,
+                                 Contact* out) {
+    std::size_t w = 0;
+    Block blk;
+    BlockOut o;
+    for (std::size_t k = 0; k < n; k += W) {
+        load_block(pairs, list + k, n - k, blk);
+        vf pax, pay, paz, pbx, pby, pbz;
+        gather3(in.positions, blk.a, pax, pay, paz);
+        gather3(in.positions, blk.b, pbx, pby, pbz);
+        const vf rsum = add(gather_or(in.sphere_radii, blk.a, 0.5f), gather_or(in.sphere_radii, blk.b, 0.5f));
+        const vf dx = sub(pbx, pax), dy = sub(pby, pay), dz = sub(pbz, paz);
+        const vf dist2 = dot(dx, dy, dz, dx, dy, dz);
+        const unsigned hits = bits(lt(dist2, mul(rsum, rsum))) & blk.valid;
+        if (!hits) continue;
+        const vf dist = sqrt(dist2);
+        const vf apart = gt(dist, set1(1e-12f));
+        // Coincident centers: arbitrary y-up normal
+        store(o.nx, select(apart, div(dx, dist), set1(0.0f)));
+        store(o.ny, select(apart, div(dy, dist), set1(1.0f)));
+        store(o.nz, select(apart, div(dz, dist), set1(0.0f)));
+        store(o.pen, select(apart, sub(rsum, dist), rsum));
+        materials(in, blk, o);
+        w = compact(blk, o, hits, out, w);
+    }
+    return w;
+}
+
+std::size_t sphere_box_bucket(const Inputs& in, const Pair* pairs, const std::uint32_t* list, std::size_t n,
+                              Contact* out) {
+    std::size_t w = 0;
+    Block blk;
+    BlockOut o;
+    alignas(32) std::uint32_t sphere[W], box[W];
+    for (std::size_t k = 0; k < n; k += W) {
+        load_block(pairs, list + k, n - k, blk);
+        for (std::size_t l = 0; l < W; ++l) {
+            const bool a_is_sphere = in.shape_types[blk.a[l]] == static_cast<std::uint8_t>(ShapeType::Sphere);
+            sphere[l] = a_is_sphere ? blk.a[l] : blk.b[l];
+            box[l] = a_is_sphere ? blk.b[l] : blk.a[l];
+        }
+        vf sx, sy, sz, cx, cy, cz, hx, hy, hz;
+        gather3(in.positions, sphere, sx, sy, sz);
+        gather3(in.positions, box, cx, cy, cz);
+        gather_half_extents(in.box_half_extents, box, hx, hy, hz);
+        const vf r = gather_or(in.sphere_radii, sphere, 0.5f);
+        // Closest point on the box to the sphere center
+        const vf dx = sub(sx, max(sub(cx, hx), min(sx, add(cx, hx))));
+        const vf dy = sub(sy, max(sub(cy, hy), min(sy, add(cy, hy))));
+        const vf dz = sub(sz, max(sub(cz, hz), min(sz, add(cz, hz))));
+        const vf dist2 = dot(dx, dy, dz, dx, dy, dz);
+        const unsigned hits = bits(lt(dist2, mul(r, r))) & blk.valid;
+        if (!hits) continue;
+        const vf dist = sqrt(dist2);
+        // Normal from the closest point to the sphere center
+        store(o.nx, div(dx, dist));
+        store(o.ny, div(dy, dist));
+        store(o.nz, div(dz, dist));
+        store(o.pen, sub(r, dist));
+        materials(in, blk, o);
+        // Centers inside the box (rare) take the scalar face-selection path
+        unsigned deep = hits & ~bits(gt(dist, set1(1e-6f)));
+        while (deep) {
+            const unsigned l = static_cast<unsigned>(std::countr_zero(deep));
+            deep &= deep - 1;
+            Vec3 normal{0, 0, 0};
+            float pen = 0.0f;
+            const Vec3 h = in.box_half_extents ? in.box_half_extents[box[l]] : Vec3{0.5f, 0.5f, 0.5f};
+            const float rad = in.sphere_radii ? in.sphere_radii[sphere[l]] : 0.5f;
+            collide_sphere_box(in.positions[sphere[l]], rad, in.positions[box[l]], h, normal, pen);
+            o.nx[l] = normal.x; o.ny[l] = normal.y; o.nz[l] = normal.z; o.pen[l] = pen;
+        }
+        w = compact(blk, o, hits, out, w);
+    }
+    return w;
+}
+
+// Axis-aligned boxes: overlap on every axis, normal along the axis of least
+// penetration (first of x, y, z on ties), pointing from a to b
+std::size_t box_box_bucket(const Inputs& in, const Pair* pairs, const std::uint32_t* list, std::size_t n,
+                           Contact* out) {
+    std::size_t w = 0;
+    Block blk;
+    BlockOut o;
+    const vf zero = set1(0.0f), one = set1(1.0f), minus_one = set1(-1.0f);
+    for (std::size_t k = 0; k < n; k += W) {
+        load_block(pairs, list + k, n - k, blk);
+        vf ax, ay, az, bx, by, bz, hax, hay, haz, hbx, hby, hbz;
+        gather3(in.positions, blk.a, ax, ay, az);
+        gather3(in.positions, blk.b, bx, by, bz);
+        gather_half_extents(in.box_half_extents, blk.a, hax, hay, haz);
+        gather_half_extents(in.box_half_extents, blk.b, hbx, hby, hbz);
+        const vf ox = sub(add(hax, hbx), abs(sub(bx, ax)));
+        const vf oy = sub(add(hay, hby), abs(sub(by, ay)));
+        const vf oz = sub(add(haz, hbz), abs(sub(bz, az)));
+        const unsigned hits = bits(mask_and(mask_and(gt(ox, zero), gt(oy, zero)), gt(oz, zero))) & blk.valid;
+        if (!hits) continue;
+        const vf use_y = lt(oy, ox);
+        const vf min_xy = select(use_y, oy, ox);
+        const vf use_z = lt(oz, min_xy);
+        store(o.pen, select(use_z, oz, min_xy));
+        store(o.nx, select(use_z, zero, select(use_y, zero, select(gt(bx, ax), one, minus_one))));
+        store(o.ny, select(use_z, zero, select(use_y, select(gt(by, ay), one, minus_one), zero)));
+        store(o.nz, select(use_z, select(gt(bz, az), one, minus_one), zero));
+        materials(in, blk, o);
+        w = compact(blk, o, hits, out, w);
+    }
+    return w;
 }
 
+} // namespace
+
 // Unified narrowphase dispatcher
 void generate_contacts(const Vec3* positions,
                        const uint8_t* shape_types,
@@ -156,71 +309,49 @@ void generate_contacts(const Vec3* positions,
                        const std::vector<Pair>& pairs,
                        std::vector<Contact>& out)
 {
-    if (!positions || !shape_types) return;
-    
-    for (const Pair &p : pairs) {
-        const ShapeType type_a = static_cast<ShapeType>(shape_types[p.a]);
-        const ShapeType type_b = static_cast<ShapeType>(shape_types[p.b]);
-        
-        Vec3 normal{0,0,0};
-        float penetration = 0.0f;
-        bool colliding = false;
-        
-        const Vec3 pa = positions[p.a];
-        const Vec3 pb = positions[p.b];
-        
-        if (type_a == ShapeType::Sphere && type_b == ShapeType::Sphere) {
-            // Sphere-Sphere
-            const float ra = sphere_radii ? sphere_radii[p.a] : 0.5f;
-            const float rb = sphere_radii ? sphere_radii[p.b] : 0.5f;
-            const float dx = pb.x - pa.x;
-            const float dy = pb.y - pa.y;
-            const float dz = pb.z - pa.z;
-            const float dist2 = dx*dx + dy*dy + dz*dz;
-            const float rsum = ra + rb;
-            if (dist2 < rsum * rsum) {
-                const float dist = std::sqrt(dist2);
-                if (dist > 1e-12f) {
-                    normal.x = dx / dist; normal.y = dy / dist; normal.z = dz / dist;
-                    penetration = rsum - dist;
-                } else {
-                    normal = Vec3{0, 1, 0};
-                    penetration = rsum;
-                }
-                colliding = true;
-            }
-        } else if ((type_a == ShapeType::Sphere && type_b == ShapeType::Box) ||
-                   (type_a == ShapeType::Box && type_b == ShapeType::Sphere)) {
-            // Sphere-Box
-            const bool a_is_sphere = (type_a == ShapeType::Sphere);
-            const Vec3 sphere_center = a_is_sphere ? pa : pb;
-            const Vec3 box_center = a_is_sphere ? pb : pa;
-            const float radius = (sphere_radii && a_is_sphere) ? sphere_radii[p.a] : 
-                                 (sphere_radii && !a_is_sphere) ? sphere_radii[p.b] : 0.5f;
-            const Vec3 half_ext = (box_half_extents && !a_is_sphere) ? box_half_extents[p.a] :
-                                  (box_half_extents && a_is_sphere) ? box_half_extents[p.b] : Vec3{0.5f,0.5f,0.5f};
-            
-            colliding = collide_sphere_box(sphere_center, radius, box_center, half_ext, normal, penetration);
-            // collide_sphere_box returns normal FROM box TO sphere (separation direction)
-            // This is what we want regardless of which body is 'a' - it separates them
-        } else if (type_a == ShapeType::Box && type_b == ShapeType::Box) {
-            // Box-Box (axis-aligned)
-            const Vec3 ha = box_half_extents ? box_half_extents[p.a] : Vec3{0.5f,0.5f,0.5f};
-            const Vec3 hb = box_half_extents ? box_half_extents[p.b] : Vec3{0.5f,0.5f,0.5f};
-            colliding = collide_box_box(pa, ha, pb, hb, normal, penetration);
-        }
-        
-        if (colliding) {
-            // Combine material properties
-            const float fa = frictions ? frictions[p.a] : 0.5f;
-            const float fb = frictions ? frictions[p.b] : 0.5f;
-            const float combined_friction = std::sqrt(fa * fb);
-            const float ra = restitutions ? restitutions[p.a] : 0.0f;
-            const float rb = restitutions ? restitutions[p.b] : 0.0f;
-            const float combined_restitution = (ra < rb) ? ra : rb;
-            out.push_back(Contact{p.a, p.b, normal.x, normal.y, normal.z, penetration, combined_friction, combined_restitution});
-        }
+    generate_contacts(positions, shape_types, sphere_radii, box_half_extents,
+                      frictions, restitutions, count, pairs.data(), pairs.size(), out);
+}
+
+void generate_contacts(const Vec3* positions,
+                       const uint8_t* shape_types,
+                       const float* sphere_radii,
+                       const Vec3* box_half_extents,
+                       const float* frictions,
+                       const float* restitutions,
+                       std::size_t /*count*/,
+                       const Pair* pairs,
+                       std::size_t pair_count,
+                       std::vector<Contact>& out)
+{
+    if (!positions || !shape_types || !pairs) return;
+    const Inputs in{positions, shape_types, sphere_radii, box_half_extents, frictions, restitutions};
+    Scratch& sc = scratch;
+
+    // 1) Bucket pair positions by shape combination. Every list is written
+    // and only the matching count advances: no branch, no memory-carried count.
+    for (auto& l : sc.list) if (l.size() < pair_count) l.resize(pair_count);
+    std::uint32_t* l0 = sc.list[SphereSphere].data();
+    std::uint32_t* l1 = sc.list[SphereBox].data();
+    std::uint32_t* l2 = sc.list[BoxBox].data();
+    std::size_t n0 = 0, n1 = 0, n2 = 0;
+    for (std::size_t pi = 0; pi < pair_count; ++pi) {
+        const std::uint32_t ta = shape_types[pairs[pi].a];
+        const std::uint32_t tb = shape_types[pairs[pi].b];
+        const std::uint32_t k = ((ta | tb) > 1u) ? 3u : ta + tb; // 3: unknown shape type, skipped
+        const std::uint32_t i = static_cast<std::uint32_t>(pi);
+        l0[n0] = i; l1[n1] = i; l2[n2] = i;
+        n0 += (k == 0u); n1 += (k == 1u); n2 += (k == 2u);
     }
+
+    // 2) One kernel per bucket, appending to a shared buffer with W slots of slack
+    if (sc.contacts.size() < pair_count + W) sc.contacts.resize(pair_count + W);
+    Contact* buf = sc.contacts.data();
+    std::size_t found = 0;
+    if (n0) found += sphere_sphere_bucket(in, pairs, l0, n0, buf + found);
+    if (n1) found += sphere_box_bucket(in, pairs, l1, n1, buf + found);
+    if (n2) found += box_box_bucket(in, pairs, l2, n2, buf + found);
+    out.insert(out.end(), buf, buf + found);
 }
 
 } // namespace ape
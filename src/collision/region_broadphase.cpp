@@ -0,0 +1,180 @@
+#include "ape/broadphase.h"
+#include "ape/job.h"
+#include <algorithm>
+#include <cmath>
+#include "foundation/frame_arena.h"
+
+namespace ape
+{
+    namespace
+    {
+        inline bool is_empty(const AABB &b)
+        {
+            return b.min_x > b.max_x || b.min_y > b.max_y || b.min_z > b.max_z;
+        }
+
+        // Region column/row of a coordinate; monotonic in v, so a point inside a
+        // box always maps into the box's region range
+        inline std::uint32_t region_coord(float v, float origin, float inv_size, std::uint32_t regions)
+        {
+            const float t = std::floor((v - origin) * inv_size);
+            if (!(t > 0.0f)) return 0; // also NaN (infinite boxes with inv_size == 0)
+            if (t >= static_cast<float>(regions - 1)) return regions - 1;
+            return static_cast<std::uint32_t>(t);
+        }
+
+        template <class F>
+        void run_chunks(JobSystem *jobs, std::size_t count, std::size_t grain, F &&fn)
+        {
+            if (jobs) jobs->parallel_for(count, grain, fn);
+            else if (count > 0) fn(std::size_t{0}, count);
+        }
+    }
+
+    void RegionBroadphase::clear()
+    {
+        region_start_.clear();
+        items_.clear();
+        region_pairs_.clear();
+        pair_start_.clear();
+    }
+
+    void RegionBroadphase::update(const AABB *boxes, std::size_t count, std::vector<Pair> &out, JobSystem *jobs,
+                                  const CollisionFilter *filters)
+    {
+        out.clear();
+        regions_x_ = regions_z_ = 1;
+        if (!boxes || count < 2) return;
+
+        // 1) X/Z bounds of the occupied boxes
+        float min_x = std::numeric_limits<float>::infinity(), min_z = min_x;
+        float max_x = -min_x, max_z = -min_x;
+        std::size_t live = 0;
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const AABB &b = boxes[i];
+            if (is_empty(b)) continue;
+            min_x = std::min(min_x, b.min_x); max_x = std::max(max_x, b.max_x);
+            min_z = std::min(min_z, b.min_z); max_z = std::max(max_z, b.max_z);
+            ++live;
+        }
+        if (live < 2) return;
+
+        // 2) Region layout: about boxes_per_region boxes each, cells as square
+        // as the bounds allow. A degenerate or unbounded axis gets one region.
+        const float width_x = max_x - min_x, width_z = max_z - min_z;
+        const bool split_x = std::isfinite(width_x) && width_x > 0.0f;
+        const bool split_z = std::isfinite(width_z) && width_z > 0.0f;
+        if (fixed_x_ > 0 || fixed_z_ > 0)
+        {
+            regions_x_ = std::clamp<std::uint32_t>(fixed_x_, 1, max_regions_per_axis);
+            regions_z_ = std::clamp<std::uint32_t>(fixed_z_, 1, max_regions_per_axis);
+        }
+        else
+        {
+            const double target = std::clamp<double>(static_cast<double>(live / boxes_per_region), 1.0,
+                                                     double(max_regions_per_axis) * max_regions_per_axis);
+            double rx = 1.0, rz = 1.0;
+            if (split_x && split_z) rx = std::round(std::sqrt(target * width_x / width_z));
+            else if (split_x) rx = target;
+            rx = std::clamp(rx, 1.0, double(max_regions_per_axis));
+            if (split_z) rz = std::clamp(std::ceil(target / rx), 1.0, double(max_regions_per_axis));
+            regions_x_ = static_cast<std::uint32_t>(rx);
+            regions_z_ = static_cast<std::uint32_t>(rz);
+        }
+        if (!split_x) regions_x_ = 1;
+        if (!split_z) regions_z_ = 1;
+        origin_x_ = split_x ? min_x : 0.0f;
+        origin_z_ = split_z ? min_z : 0.0f;
+        inv_size_x_ = split_x ? static_cast<float>(regions_x_) / width_x : 0.0f;
+        inv_size_z_ = split_z ? static_cast<float>(regions_z_) / width_z : 0.0f;
+        const std::uint32_t regions = regions_x_ * regions_z_;
+
+        // 3) Register every box in each region it touches (counting sort, so
+        // each region lists its boxes in ascending index order)
+        resize_scratch(region_start_, static_cast<std::size_t>(regions) + 1);
+        std::fill(region_start_.begin(), region_start_.end(), 0u);
+        auto region_range = [&](const AABB &b, std::uint32_t &x0, std::uint32_t &x1, std::uint32_t &z0, std::uint32_t &z1) {
+            x0 = region_coord(b.min_x, origin_x_, inv_size_x_, regions_x_);
+            x1 = region_coord(b.max_x, origin_x_, inv_size_x_, regions_x_);
+            z0 = region_coord(b.min_z, origin_z_, inv_size_z_, regions_z_);
+            z1 = region_coord(b.max_z, origin_z_, inv_size_z_, regions_z_);
+        };
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const AABB &b = boxes[i];
+            if (is_empty(b)) continue;
+            std::uint32_t x0, x1, z0, z1;
+            region_range(b, x0, x1, z0, z1);
+            for (std::uint32_t z = z0; z <= z1; ++z)
+                for (std::uint32_t x = x0; x <= x1; ++x) ++region_start_[z * regions_x_ + x + 1];
+        }
+        for (std::uint32_t r = 0; r < regions; ++r) region_start_[r + 1] += region_start_[r];
+        resize_scratch(items_, region_start_[regions]);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const AABB &b = boxes[i];
+            if (is_empty(b)) continue;
+            std::uint32_t x0, x1, z0, z1;
+            region_range(b, x0, x1, z0, z1);
+            for (std::uint32_t z = z0; z <= z1; ++z)
+                for (std::uint32_t x = x0; x <= x1; ++x)
+                    items_[region_start_[z * regions_x_ + x]++] = Item{b.min_x, static_cast<std::uint32_t>(i)};
+        }
+        // The fill advanced every start to the next region's start; shift back
+        for (std::uint32_t r = regions; r > 0; --r) region_start_[r] = region_start_[r - 1];
+        region_start_[0] = 0;
+
+        // 4) Sweep each region independently
+        if (region_pairs_.size() < regions) region_pairs_.resize(regions);
+        run_chunks(jobs, regions, 1, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t r = begin; r < end; ++r) sweep_region(boxes, filters, static_cast<std::uint32_t>(r));
+        });
+
+        // 5) Merge: counting sort of all region lists by a, then by b within
+        // each bucket. Each pair was emitted by exactly one region.
+        resize_scratch(pair_start_, count + 1);
+        std::fill(pair_start_.begin(), pair_start_.end(), 0u);
+        for (std::uint32_t r = 0; r < regions; ++r)
+            for (const Pair &p : region_pairs_[r]) ++pair_start_[p.a + 1];
+        for (std::size_t i = 0; i < count; ++i) pair_start_[i + 1] += pair_start_[i];
+        resize_scratch(out, pair_start_[count]);
+        for (std::uint32_t r = 0; r < regions; ++r)
+            for (const Pair &p : region_pairs_[r]) out[pair_start_[p.a]++] = p;
+        for (std::size_t i = count; i > 0; --i) pair_start_[i] = pair_start_[i - 1];
+        pair_start_[0] = 0;
+        run_chunks(jobs, count, 4096, [&](std::size_t begin, std::size_t end) {
+            for (std::size_t a = begin; a < end; ++a)
+            {
+                if (pair_start_[a + 1] - pair_start_[a] < 2) continue;
+                std::sort(out.begin() + pair_start_[a], out.begin() + pair_start_[a + 1], pair_less);
+            }
+        });
+    }
+
+    void RegionBroadphase::sweep_region(const AABB *boxes, const CollisionFilter *filters, std::uint32_t region)
+    {
+        std::vector<Pair> &pairs = region_pairs_[region];
+        pairs.clear();
+        Item *first = items_.data() + region_start_[region];
+        Item *last = items_.data() + region_start_[region + 1];
+        std::sort(first, last, [](const Item &l, const Item &r) {
+            return l.min_x < r.min_x || (l.min_x == r.min_x && l.index < r.index);
+        });
+        for (Item *i = first; i != last; ++i)
+        {
+            const AABB &a = boxes[i->index];
+            for (Item *j = i + 1; j != last && j->min_x <= a.max_x; ++j)
+            {
+                const AABB &b = boxes[j->index];
+                if (!aabb_overlaps(a, b)) continue;
+                if (filters && !filters_collide(filters[i->index], filters[j->index])) continue;
+                // Owned by the region of the intersection's X/Z min corner
+                const std::uint32_t ox = region_coord(std::max(a.min_x, b.min_x), origin_x_, inv_size_x_, regions_x_);
+                const std::uint32_t oz = region_coord(std::max(a.min_z, b.min_z), origin_z_, inv_size_z_, regions_z_);
+                if (oz * regions_x_ + ox != region) continue;
+                pairs.push_back(i->index < j->index ? Pair{i->index, j->index} : Pair{j->index, i->index});
+            }
+        }
+    }
+} // namespace ape
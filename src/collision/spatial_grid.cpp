@@ -0,0 +1,156 @@
+#include "ape/broadphase.h"
+#include <algorithm>
+#include <cmath>
+#include "foundation/frame_arena.h"
+
+namespace ape
+{
+    namespace
+    {
+        inline bool is_empty(const AABB &b)
+        {
+            return b.min_x > b.max_x || b.min_y > b.max_y || b.min_z > b.max_z;
+        }
+
+        inline std::int32_t cell_coord(float v, float inv_cell)
+        {
+            // Clamp so far-away (or infinite) coordinates cannot overflow int32
+            const float c = std::floor(v * inv_cell);
+            if (c < -1073741824.0f) return -1073741824;
+            if (c > 1073741823.0f) return 1073741823;
+            return static_cast<std::int32_t>(c);
+        }
+
+        inline std::uint32_t cell_hash(std::int32_t x, std::int32_t y, std::int32_t z)
+        {
+            return (static_cast<std::uint32_t>(x) * 73856093u) ^
+                   (static_cast<std::uint32_t>(y) * 19349663u) ^
+                   (static_cast<std::uint32_t>(z) * 83492791u);
+        }
+    }
+
+    void SpatialHashGrid::clear()
+    {
+        extents_.clear();
+        entries_.clear();
+        sort_tmp_.clear();
+        large_.clear();
+        small_.clear();
+    }
+
+    void SpatialHashGrid::update(const AABB *boxes, std::size_t count, std::vector<Pair> &out,
+                                 const CollisionFilter *filters)
+    {
+        out.clear();
+        entries_.clear();
+        large_.clear();
+        small_.clear();
+        if (!boxes || count < 2) return;
+
+        // 1) Cell size from the distribution of box sizes (median largest extent)
+        if (fixed_cell_size_ > 0.0f)
+        {
+            cell_size_ = fixed_cell_size_;
+        }
+        else
+        {
+            extents_.clear();
+            for (std::size_t i = 0; i < count; ++i)
+            {
+                const AABB &b = boxes[i];
+                if (is_empty(b)) continue;
+                extents_.push_back(std::max(b.max_x - b.min_x, std::max(b.max_y - b.min_y, b.max_z - b.min_z)));
+            }
+            if (extents_.empty()) return;
+            auto mid = extents_.begin() + static_cast<std::ptrdiff_t>(extents_.size() / 2);
+            std::nth_element(extents_.begin(), mid, extents_.end());
+            cell_size_ = (*mid > 0.0f && std::isfinite(*mid)) ? *mid : 1.0f;
+        }
+        const float inv_cell = 1.0f / cell_size_;
+
+        // 2) Bin boxes into the cells they touch
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const AABB &b = boxes[i];
+            if (is_empty(b)) continue;
+            const std::int32_t x0 = cell_coord(b.min_x, inv_cell), x1 = cell_coord(b.max_x, inv_cell);
+            const std::int32_t y0 = cell_coord(b.min_y, inv_cell), y1 = cell_coord(b.max_y, inv_cell);
+            const std::int32_t z0 = cell_coord(b.min_z, inv_cell), z1 = cell_coord(b.max_z, inv_cell);
+            const std::uint64_t cells = static_cast<std::uint64_t>(x1 - x0 + 1) *
+                                        static_cast<std::uint64_t>(y1 - y0 + 1) *
+                                        static_cast<std::uint64_t>(z1 - z0 + 1);
+            const std::uint32_t idx = static_cast<std::uint32_t>(i);
+            if (cells > max_cells_per_box)
+            {
+                large_.push_back(idx);
+                continue;
+            }
+            small_.push_back(idx);
+            for (std::int32_t z = z0; z <= z1; ++z)
+                for (std::int32_t y = y0; y <= y1; ++y)
+                    for (std::int32_t x = x0; x <= x1; ++x)
+                        entries_.push_back(Entry{cell_hash(x, y, z), x, y, z, idx});
+        }
+
+        // 3) LSD radix sort by key (stable, 4 passes of 8 bits)
+        resize_scratch(sort_tmp_, entries_.size());
+        for (int shift = 0; shift < 32; shift += 8)
+        {
+            std::size_t offsets[257] = {};
+            for (const Entry &e : entries_) ++offsets[((e.key >> shift) & 0xFFu) + 1];
+            for (int k = 0; k < 256; ++k) offsets[k + 1] += offsets[k];
+            for (const Entry &e : entries_) sort_tmp_[offsets[(e.key >> shift) & 0xFFu]++] = e;
+            entries_.swap(sort_tmp_);
+        }
+
+        // 4) Pairs within each run of equal keys (hash collisions: compare coords)
+        const std::size_t m = entries_.size();
+        for (std::size_t begin = 0; begin < m;)
+        {
+            std::size_t end = begin + 1;
+            while (end < m && entries_[end].key == entries_[begin].key) ++end;
+            for (std::size_t p = begin; p + 1 < end; ++p)
+            {
+                const Entry &ep = entries_[p];
+                const AABB &bp = boxes[ep.index];
+                for (std::size_t q = p + 1; q < end; ++q)
+                {
+                    const Entry &eq = entries_[q];
+                    if (eq.cx != ep.cx || eq.cy != ep.cy || eq.cz != ep.cz) continue;
+                    const AABB &bq = boxes[eq.index];
+                    if (!aabb_overlaps(bp, bq)) continue;
+                    if (filters && !filters_collide(filters[ep.index], filters[eq.index])) continue;
+                    // Emit only from the cell containing the intersection's min corner
+                    if (cell_coord(std::max(bp.min_x, bq.min_x), inv_cell) != ep.cx ||
+                        cell_coord(std::max(bp.min_y, bq.min_y), inv_cell) != ep.cy ||
+                        cell_coord(std::max(bp.min_z, bq.min_z), inv_cell) != ep.cz)
+                        continue;
+                    out.push_back(ep.index < eq.index ? Pair{ep.index, eq.index} : Pair{eq.index, ep.index});
+                }
+            }
+            begin = end;
+        }
+
+        // 5) Oversized boxes against the binned ones (listed in step 2, so no
+        // per-slot lookups) and against each other
+        for (std::size_t k = 0; k < large_.size(); ++k)
+        {
+            const std::uint32_t l = large_[k];
+            const AABB &bl = boxes[l];
+            for (const std::uint32_t idx : small_)
+            {
+                if (!aabb_overlaps(bl, boxes[idx])) continue;
+                if (filters && !filters_collide(filters[l], filters[idx])) continue;
+                out.push_back(l < idx ? Pair{l, idx} : Pair{idx, l});
+            }
+            for (std::size_t k2 = k + 1; k2 < large_.size(); ++k2)
+            {
+                if (!aabb_overlaps(bl, boxes[large_[k2]])) continue;
+                if (filters && !filters_collide(filters[l], filters[large_[k2]])) continue;
+                out.push_back(Pair{l, large_[k2]});
+            }
+        }
+
+        std::sort(out.begin(), out.end(), pair_less);
+    }
+} // namespace ape
@@ -0,0 +1,124 @@
+#include "ape/broadphase.h"
+#include <algorithm>
+#include <iterator>
+#include "foundation/frame_arena.h"
+
+namespace ape
+{
+    namespace
+    {
+        constexpr std::uint32_t npos = 0xFFFFFFFFu;
+
+        inline float axis_min(const AABB &b, int axis) { return axis == 0 ? b.min_x : (axis == 1 ? b.min_y : b.min_z); }
+        inline float axis_max(const AABB &b, int axis) { return axis == 0 ? b.max_x : (axis == 1 ? b.max_y : b.max_z); }
+    }
+
+    void SweepAndPrune::clear()
+    {
+        count_ = 0;
+        endpoints_.clear();
+        active_.clear();
+        active_pos_.clear();
+        prev_pairs_.clear();
+        added_.clear();
+        removed_.clear();
+    }
+
+    void SweepAndPrune::rebuild(const AABB *boxes, std::size_t count)
+    {
+        endpoints_.resize(count * 2);
+        for (std::size_t i = 0; i < count; ++i)
+        {
+            const std::uint32_t idx = static_cast<std::uint32_t>(i);
+            endpoints_[2 * i] = Endpoint{axis_min(boxes[i], axis_), idx << 1};
+            endpoints_[2 * i + 1] = Endpoint{axis_max(boxes[i], axis_), (idx << 1) | 1u};
+        }
+        std::sort(endpoints_.begin(), endpoints_.end(), [](const Endpoint &a, const Endpoint &b) {
+            if (a.value != b.value) return a.value < b.value;
+            if ((a.key & 1u) != (b.key & 1u)) return (a.key & 1u) < (b.key & 1u);
+            return a.key < b.key;
+        });
+        count_ = count;
+        active_pos_.assign(count, npos);
+    }
+
+    void SweepAndPrune::update(const AABB *boxes, std::size_t count, std::vector<Pair> &out,
+                               const CollisionFilter *filters)
+    {
+        out.clear();
+        if (!boxes) count = 0;
+
+        if (count != count_)
+        {
+            rebuild(boxes, count);
+        }
+        else
+        {
+            // Refresh endpoint values, then repair order with insertion sort
+            for (Endpoint &e : endpoints_)
+            {
+                const AABB &b = boxes[e.key >> 1];
+                e.value = (e.key & 1u) ? axis_max(b, axis_) : axis_min(b, axis_);
+            }
+            const std::size_t m = endpoints_.size();
+            for (std::size_t i = 1; i < m; ++i)
+            {
+                const Endpoint e = endpoints_[i];
+                std::size_t j = i;
+                while (j > 0)
+                {
+                    const Endpoint &p = endpoints_[j - 1];
+                    const bool less = (e.value != p.value) ? (e.value < p.value)
+                                    : ((e.key & 1u) != (p.key & 1u)) ? ((e.key & 1u) < (p.key & 1u))
+                                    : (e.key < p.key);
+                    if (!less) break;
+                    endpoints_[j] = p;
+                    --j;
+                }
+                endpoints_[j] = e;
+            }
+        }
+
+        // Sweep: O(1) removal from the active list through active_pos_
+        active_.clear();
+        for (const Endpoint &e : endpoints_)
+        {
+            const std::uint32_t idx = e.key >> 1;
+            if ((e.key & 1u) == 0u)
+            {
+                const AABB &b = boxes[idx];
+                if (axis_min(b, axis_) > axis_max(b, axis_)) continue; // empty box
+                for (std::uint32_t j : active_)
+                {
+                    if (!aabb_overlaps(b, boxes[j])) continue;
+                    if (filters && !filters_collide(filters[idx], filters[j])) continue;
+                    out.push_back(idx < j ? Pair{idx, j} : Pair{j, idx});
+                }
+                active_pos_[idx] = static_cast<std::uint32_t>(active_.size());
+                active_.push_back(idx);
+            }
+            else
+            {
+                const std::uint32_t slot = active_pos_[idx];
+                if (slot == npos) continue;
+                const std::uint32_t last = active_.back();
+                active_[slot] = last;
+                active_pos_[last] = slot;
+                active_.pop_back();
+                active_pos_[idx] = npos;
+            }
+        }
+        std::sort(out.begin(), out.end(), pair_less);
+        if (!track_deltas_) return;
+
+        // Pair set difference against the previous update (both lists sorted)
+        added_.clear();
+        removed_.clear();
+        std::set_difference(out.begin(), out.end(), prev_pairs_.begin(), prev_pairs_.end(),
+                            std::back_inserter(added_), pair_less);
+        std::set_difference(prev_pairs_.begin(), prev_pairs_.end(), out.begin(), out.end(),
+                            std::back_inserter(removed_), pair_less);
+        resize_scratch(prev_pairs_, out.size());
+        std::copy(out.begin(), out.end(), prev_pairs_.begin());
+    }
+} // namespace ape
@@ -0,0 +1,80 @@
+#include "ape/contact_cache.h"
+#include <cstring>
+
+namespace ape {
+
+void ContactCache::clear() {
+    slots_.clear();
+    stamp_ = 1;
+    size_ = 0;
+}
+
+bool ContactCache::restore(const std::byte* slots, std::size_t slot_count, std::uint32_t stamp, std::size_t size) {
+    if ((slot_count & (slot_count - 1)) != 0 || size * 2 > slot_count || stamp == 0) return false;
+    std::vector<Entry> table(slot_count);
+    if (slot_count) std::memcpy(table.data(), slots, slot_count * sizeof(Entry));
+    std::size_t live = 0;
+    for (const Entry& e : table) live += (e.stamp == stamp);
+    if (live != size) return false;
+    slots_.swap(table);
+    stamp_ = stamp;
+    size_ = size;
+    return true;
+}
+
+void ContactCache::reset(std::size_t expected) {
+    size_ = 0;
+    std::size_t want = 16;
+    while (want < expected * 2) want <<= 1;
+    if (want > slots_.size()) {
+        slots_.assign(want, Entry{0, 0, 0.0f, Vec3{0,0,0}, 0});
+        stamp_ = 1;
+        return;
+    }
+    if (++stamp_ == 0) {
+        // Stamp wrapped: clear stale stamps once
+        for (Entry& e : slots_) e.stamp = 0;
+        stamp_ = 1;
+    }
+}
+
+void ContactCache::insert(std::uint32_t a, std::uint32_t b, float normal_impulse, const Vec3& tangent_impulse) {
+    if ((size_ + 1) * 2 > slots_.size()) {
+        // More inserts than announced in reset(): grow and rehash live entries
+        std::vector<Entry> old;
+        old.swap(slots_);
+        const std::uint32_t old_stamp = stamp_;
+        reset((size_ + 1) * 2);
+        for (const Entry& e : old) {
+            if (e.stamp == old_stamp) insert(static_cast<std::uint32_t>(e.key >> 32), static_cast<std::uint32_t>(e.key), e.normal_impulse, e.tangent_impulse);
+        }
+    }
+    const std::uint64_t key = make_key(a, b);
+    const std::size_t mask = slots_.size() - 1;
+    for (std::size_t i = hash(key) & mask;; i = (i + 1) & mask) {
+        Entry& e = slots_[i];
+        if (e.stamp != stamp_) {
+            e = Entry{key, stamp_, normal_impulse, tangent_impulse, 0};
+            ++size_;
+            return;
+        }
+        if (e.key == key) {
+            e.normal_impulse = normal_impulse;
+            e.tangent_impulse = tangent_impulse;
+            return;
+        }
+    }
+}
+
+const ContactCache::Entry* ContactCache::find(std::uint32_t a, std::uint32_t b) const {
+    if (size_ == 0) return nullptr;
+    const std::uint64_t key = make_key(a, b);
+    const std::size_t mask = slots_.size() - 1;
+    for (std::size_t i = hash(key) & mask;; i = (i + 1) & mask) {
+        const Entry& e = slots_[i];
+        if (e.stamp != stamp_) return nullptr;
+        if (e.key == key) return &e;
+    }
+}
+
+} // namespace ape
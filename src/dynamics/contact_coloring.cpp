@@ -0,0 +1,63 @@
+#include "ape/contact_coloring.h"
+#include <bit>
+#include "foundation/frame_arena.h"
+
+namespace ape {
+
+void ContactColoring::build(std::size_t body_count,
+                            const float* mass,
+                            const Contact* contacts,
+                            const std::uint32_t* order,
+                            std::size_t count)
+{
+    // Only the masks of bodies in these contacts are read, so only those are
+    // cleared: the cost follows the contacts, not the body capacity
+    resize_scratch(body_colors_, body_count);
+    for (std::size_t k = 0; k < count; ++k) {
+        const Contact& c = contacts[order[k]];
+        body_colors_[c.a] = 0;
+        body_colors_[c.b] = 0;
+    }
+    resize_scratch(color_, count);
+
+    // 1) Greedy color per contact, counting batch sizes
+    std::uint32_t sizes[max_colors + 1] = {};
+    for (std::size_t k = 0; k < count; ++k) {
+        const Contact& c = contacts[order[k]];
+        const bool dyn_a = mass[c.a] > 0.0f;
+        const bool dyn_b = mass[c.b] > 0.0f;
+        std::uint64_t used = 0;
+        if (dyn_a) used |= body_colors_[c.a];
+        if (dyn_b) used |= body_colors_[c.b];
+        std::uint8_t col = static_cast<std::uint8_t>(max_colors);
+        if (used != ~std::uint64_t{0}) {
+            col = static_cast<std::uint8_t>(std::countr_one(used));
+            const std::uint64_t bit = std::uint64_t{1} << col;
+            if (dyn_a) body_colors_[c.a] |= bit;
+            if (dyn_b) body_colors_[c.b] |= bit;
+        }
+        color_[k] = col;
+        ++sizes[col];
+    }
+
+    // 2) Compact non-empty colors into batches (overflow last), list order kept
+    std::uint32_t batch_of[max_colors + 1];
+    batch_start_.assign(1, 0);
+    for (std::size_t col = 0; col <= max_colors; ++col) {
+        if (sizes[col] == 0) continue;
+        batch_of[col] = static_cast<std::uint32_t>(batch_start_.size() - 1);
+        batch_start_.push_back(batch_start_.back() + sizes[col]);
+    }
+    has_overflow_ = sizes[max_colors] != 0;
+
+    resize_scratch(contacts_, count);
+    std::uint32_t write[max_colors + 1];
+    for (std::size_t col = 0; col <= max_colors; ++col) {
+        if (sizes[col] != 0) write[col] = batch_start_[batch_of[col]];
+    }
+    for (std::size_t k = 0; k < count; ++k) {
+        contacts_[write[color_[k]]++] = order[k];
+    }
+}
+
+} // namespace ape
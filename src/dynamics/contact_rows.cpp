@@ -0,0 +1,196 @@
+#include "ape/contact_rows.h"
+#include "ape/job.h"
+#include "foundation/simd.h"
+
+namespace ape {
+
+using namespace simd;
+
+namespace {
+// Write lane velocities back for the active lanes; only finite-mass bodies are
+// written since several lanes may share a static body
+inline void scatter(Vec3* vel, const std::uint32_t* idx, const float* inv_mass, std::size_t active, vf x, vf y, vf z) {
+    alignas(32) float lx[W], ly[W], lz[W];
+    store(lx, x); store(ly, y); store(lz, z);
+    for (std::size_t l = 0; l < active; ++l) {
+        if (inv_mass[l] > 0.0f) vel[idx[l]] = Vec3{lx[l], ly[l], lz[l]};
+    }
+}
+
+constexpr std::uint32_t no_contact = 0xFFFFFFFFu;
+constexpr std::size_t group_grain = 16; // groups per job
+} // namespace
+
+std::size_t ContactRows::laneWidth() { return W; }
+
+void ContactRows::build(const ContactColoring& coloring,
+                        const Contact* contacts,
+                        const float* mass,
+                        const float* impulses_n,
+                        const Vec3* impulses_t)
+{
+    const std::size_t batches = coloring.batchCount();
+
+    // 1) Group layout: full groups for independent batches, one active lane
+    // per group for the overflow batch; every group starts on a W boundary
+    group_start_.assign(1, 0);
+    independent_.resize(batches);
+    active_.clear();
+    contact_.clear();
+    const auto pad = [this] { while (contact_.size() % W != 0) contact_.push_back(no_contact); };
+    for (std::size_t k = 0; k < batches; ++k) {
+        const bool indep = coloring.independent(k);
+        const std::size_t per_group = indep ? W : 1;
+        independent_[k] = indep ? 1 : 0;
+        std::size_t lane = per_group;
+        for (std::uint32_t i : coloring.batch(k)) {
+            const Contact& c = contacts[i];
+            if (mass[c.a] <= 0.0f && mass[c.b] <= 0.0f) continue;
+            if (lane == per_group) { pad(); active_.push_back(0); lane = 0; }
+            contact_.push_back(i);
+            ++active_.back();
+            ++lane;
+        }
+        group_start_.push_back(static_cast<std::uint32_t>(active_.size()));
+    }
+    pad();
+
+    // 2) SoA rows
+    const std::size_t lanes = contact_.size();
+    Rows& r = rows_;
+    // Padding lanes keep a = b = 0 (gathers stay in bounds) and zero masses
+    for (auto* v : {&r.a, &r.b}) v->assign(lanes, 0);
+    for (auto* v : {&r.nx, &r.ny, &r.nz, &r.penetration, &r.friction, &r.restitution, &r.inv_mass_a,
+                    &r.inv_mass_b, &r.normal_mass, &r.bias, &r.jn, &r.jtx, &r.jty, &r.jtz}) v->assign(lanes, 0.0f);
+    for (std::size_t l = 0; l < lanes; ++l) {
+        const std::uint32_t i = contact_[l];
+        if (i == no_contact) continue;
+        const Contact& c = contacts[i];
+        r.a[l] = c.a;
+        r.b[l] = c.b;
+        r.nx[l] = c.nx; r.ny[l] = c.ny; r.nz[l] = c.nz;
+        r.penetration[l] = c.penetration;
+        r.friction[l] = c.friction;
+        r.restitution[l] = c.restitution;
+        r.inv_mass_a[l] = (mass[c.a] > 0.0f) ? (1.0f / mass[c.a]) : 0.0f;
+        r.inv_mass_b[l] = (mass[c.b] > 0.0f) ? (1.0f / mass[c.b]) : 0.0f;
+        r.normal_mass[l] = 1.0f / (r.inv_mass_a[l] + r.inv_mass_b[l]);
+        r.jn[l] = impulses_n[i];
+        r.jtx[l] = impulses_t[i].x; r.jty[l] = impulses_t[i].y; r.jtz[l] = impulses_t[i].z;
+    }
+}
+
+// Run kernel(group) over every group, batch by batch; groups of an independent
+// batch touch disjoint finite-mass bodies and may run concurrently.
+template <class Kernel>
+void ContactRows::run(JobSystem* jobs, Kernel&& kernel) const {
+    const std::size_t batches = independent_.size();
+    for (std::size_t k = 0; k < batches; ++k) {
+        const std::size_t first = group_start_[k];
+        const std::size_t count = group_start_[k + 1] - first;
+        if (jobs && independent_[k] && count > group_grain) {
+            jobs->parallel_for(count, group_grain, [&](std::size_t b, std::size_t e) {
+                for (std::size_t g = b; g < e; ++g) kernel(first + g);
+            });
+        } else {
+            for (std::size_t g = 0; g < count; ++g) kernel(first + g);
+        }
+    }
+}
+
+void ContactRows::warmStart(Vec3* vel, JobSystem* jobs) const {
+    const Rows& r = rows_;
+    run(jobs, [&](std::size_t g) {
+        const std::size_t o = g * W;
+        vf ax, ay, az, bx, by, bz;
+        gather3(vel, &r.a[o], ax, ay, az);
+        gather3(vel, &r.b[o], bx, by, bz);
+        const vf nx = load(&r.nx[o]), ny = load(&r.ny[o]), nz = load(&r.nz[o]);
+        const vf ima = load(&r.inv_mass_a[o]), imb = load(&r.inv_mass_b[o]);
+        const vf jn = load(&r.jn[o]);
+        const vf jtx = load(&r.jtx[o]), jty = load(&r.jty[o]), jtz = load(&r.jtz[o]);
+        const vf jna = mul(jn, ima), jnb = mul(jn, imb);
+        ax = sub(ax, mul(nx, jna)); ay = sub(ay, mul(ny, jna)); az = sub(az, mul(nz, jna));
+        bx = add(bx, mul(nx, jnb)); by = add(by, mul(ny, jnb)); bz = add(bz, mul(nz, jnb));
+        ax = sub(ax, mul(jtx, ima)); ay = sub(ay, mul(jty, ima)); az = sub(az, mul(jtz, ima));
+        bx = add(bx, mul(jtx, imb)); by = add(by, mul(jty, imb)); bz = add(bz, mul(jtz, imb));
+        scatter(vel, &r.a[o], &r.inv_mass_a[o], active_[g], ax, ay, az);
+        scatter(vel, &r.b[o], &r.inv_mass_b[o], active_[g], bx, by, bz);
+    });
+}
+
+void ContactRows::solve(Vec3* vel, float dt, int iterations, float baumgarte, JobSystem* jobs) {
+    if (dt <= 0.0f) return;
+    Rows& r = rows_;
+    const vf zero = set1(0.0f);
+    // Baumgarte velocity bias is fixed for the whole solve
+    const std::size_t lanes = contact_.size();
+    for (std::size_t l = 0; l < lanes; l += W) {
+        store(&r.bias[l], mul(set1(baumgarte), div(load(&r.penetration[l]), set1(dt))));
+    }
+    for (int iter = 0; iter < iterations; ++iter) {
+        const bool first_iter = iter == 0;
+        run(jobs, [&](std::size_t g) {
+            const std::size_t o = g * W;
+            vf ax, ay, az, bx, by, bz;
+            gather3(vel, &r.a[o], ax, ay, az);
+            gather3(vel, &r.b[o], bx, by, bz);
+            const vf nx = load(&r.nx[o]), ny = load(&r.ny[o]), nz = load(&r.nz[o]);
+            const vf ima = load(&r.inv_mass_a[o]), imb = load(&r.inv_mass_b[o]);
+            const vf m_n = load(&r.normal_mass[o]);
+
+            // Normal impulse with Baumgarte bias (restitution on the first iteration)
+            const vf vn = dot(sub(bx, ax), sub(by, ay), sub(bz, az), nx, ny, nz);
+            vf bias = load(&r.bias[o]);
+            if (first_iter) {
+                const vf e = load(&r.restitution[o]);
+                const vf bounce = mask_and(gt(e, zero), lt(vn, set1(-0.1f)));
+                bias = select(bounce, sub(bias, mul(e, vn)), bias);
+            }
+            const vf jn_old = load(&r.jn[o]);
+            const vf jn = max(add(jn_old, mul(neg(add(vn, bias)), m_n)), zero);
+            const vf djn = sub(jn, jn_old);
+            const vf dja = mul(djn, ima), djb = mul(djn, imb);
+            ax = sub(ax, mul(nx, dja)); ay = sub(ay, mul(ny, dja)); az = sub(az, mul(nz, dja));
+            bx = add(bx, mul(nx, djb)); by = add(by, mul(ny, djb)); bz = add(bz, mul(nz, djb));
+            store(&r.jn[o], jn);
+
+            // Friction from the post-normal-impulse relative velocity, clamped to the cone
+            const vf mu = load(&r.friction[o]);
+            const vf rx = sub(bx, ax), ry = sub(by, ay), rz = sub(bz, az);
+            const vf vn2 = dot(rx, ry, rz, nx, ny, nz);
+            const vf tx0 = sub(rx, mul(vn2, nx)), ty0 = sub(ry, mul(vn2, ny)), tz0 = sub(rz, mul(vn2, nz));
+            const vf vt = sqrt(dot(tx0, ty0, tz0, tx0, ty0, tz0));
+            const vf sliding = mask_and(gt(mu, zero), gt(vt, set1(1e-6f)));
+            const vf inv_vt = div(set1(1.0f), vt);
+            const vf tx = select(sliding, mul(tx0, inv_vt), zero);
+            const vf ty = select(sliding, mul(ty0, inv_vt), zero);
+            const vf tz = select(sliding, mul(tz0, inv_vt), zero);
+            vf jtx = load(&r.jtx[o]), jty = load(&r.jty[o]), jtz = load(&r.jtz[o]);
+            const vf jt_old = sqrt(dot(jtx, jty, jtz, jtx, jty, jtz));
+            const vf max_f = mul(mu, jn);
+            const vf jt_new = max(min(add(jt_old, mul(neg(vt), m_n)), max_f), neg(max_f));
+            vf djt = sub(jt_new, jt_old);
+            djt = select(mask_and(sliding, gt(abs(djt), set1(1e-9f))), djt, zero);
+            const vf dx = mul(tx, djt), dy = mul(ty, djt), dz = mul(tz, djt);
+            ax = sub(ax, mul(dx, ima)); ay = sub(ay, mul(dy, ima)); az = sub(az, mul(dz, ima));
+            bx = add(bx, mul(dx, imb)); by = add(by, mul(dy, imb)); bz = add(bz, mul(dz, imb));
+            jtx = add(jtx, dx); jty = add(jty, dy); jtz = add(jtz, dz);
+            store(&r.jtx[o], jtx); store(&r.jty[o], jty); store(&r.jtz[o], jtz);
+
+            scatter(vel, &r.a[o], &r.inv_mass_a[o], active_[g], ax, ay, az);
+            scatter(vel, &r.b[o], &r.inv_mass_b[o], active_[g], bx, by, bz);
+        });
+    }
+}
+
+void ContactRows::storeImpulses(float* impulses_n, Vec3* impulses_t) const {
+    for (std::size_t l = 0; l < contact_.size(); ++l) {
+        const std::uint32_t i = contact_[l];
+        if (i == no_contact) continue;
+        impulses_n[i] = rows_.jn[l];
+        impulses_t[i] = Vec3{rows_.jtx[l], rows_.jty[l], rows_.jtz[l]};
+    }
+}
+
+} // namespace ape
@@ -0,0 +1,104 @@
+#include "ape/island.h"
+#include <algorithm>
+#include "foundation/frame_arena.h"
+
+namespace ape {
+
+std::uint32_t IslandBuilder::find(std::uint32_t i) {
+    // Path halving
+    while (parent_[i] != i) {
+        parent_[i] = parent_[parent_[i]];
+        i = parent_[i];
+    }
+    return i;
+}
+
+void IslandBuilder::build(std::size_t body_count,
+                          const std::uint8_t* alive,
+                          const float* mass,
+                          const Contact* contacts,
+                          std::size_t contact_count)
+{
+    listed_.clear();
+    for (std::size_t i = 0; i < body_count; ++i) {
+        if (alive[i]) listed_.push_back(static_cast<std::uint32_t>(i));
+    }
+    build(body_count, listed_, mass, contacts, contact_count);
+}
+
+void IslandBuilder::build(std::size_t body_count,
+                          std::span<const std::uint32_t> bodies,
+                          const float* mass,
+                          const Contact* contacts,
+                          std::size_t contact_count)
+{
+    // Per-body arrays are indexed by body but only the listed entries are
+    // touched. body_island_ stays npos everywhere else: the previous build's
+    // bodies (still in bodies_) are cleared first and new slots start at npos.
+    for (std::uint32_t b : bodies_) {
+        if (b < body_island_.size()) body_island_[b] = npos;
+    }
+    const std::size_t known = std::min(body_island_.size(), body_count);
+    resize_scratch(body_island_, body_count);
+    std::fill(body_island_.begin() + static_cast<std::ptrdiff_t>(known), body_island_.end(), npos);
+    resize_scratch(parent_, body_count);
+    resize_scratch(root_island_, body_count);
+    for (std::uint32_t b : bodies) {
+        parent_[b] = b;
+        root_island_[b] = npos;
+    }
+
+    // 1) Union bodies touching through contacts (finite mass only)
+    for (std::size_t k = 0; k < contact_count; ++k) {
+        const Contact& c = contacts[k];
+        if (mass[c.a] <= 0.0f || mass[c.b] <= 0.0f) continue;
+        const std::uint32_t ra = find(c.a);
+        const std::uint32_t rb = find(c.b);
+        if (ra == rb) continue;
+        // Lower root wins: keeps the structure independent of contact order
+        if (ra < rb) parent_[rb] = ra; else parent_[ra] = rb;
+    }
+
+    // 2) Number islands by lowest body index and count bodies per island
+    body_start_.clear();
+    body_start_.push_back(0);
+    std::uint32_t islands = 0;
+    for (std::uint32_t b : bodies) {
+        const std::uint32_t r = find(b);
+        if (root_island_[r] == npos) {
+            root_island_[r] = islands++;
+            body_start_.push_back(0);
+        }
+        const std::uint32_t isl = root_island_[r];
+        body_island_[b] = isl;
+        ++body_start_[isl + 1];
+    }
+    for (std::uint32_t k = 0; k < islands; ++k) body_start_[k + 1] += body_start_[k];
+    resize_scratch(bodies_, body_start_[islands]);
+    // Write cursors per island (cursor_ is reused for contacts below)
+    resize_scratch(cursor_, static_cast<std::size_t>(islands) + 1);
+    std::copy(body_start_.begin(), body_start_.end(), cursor_.begin());
+    for (std::uint32_t b : bodies) bodies_[cursor_[body_island_[b]]++] = b;
+
+    // 3) Contacts per island (ascending contact index)
+    resize_scratch(contact_island_, contact_count);
+    resize_scratch(contact_start_, static_cast<std::size_t>(islands) + 1);
+    std::fill(contact_start_.begin(), contact_start_.end(), 0u);
+    for (std::size_t k = 0; k < contact_count; ++k) {
+        const Contact& c = contacts[k];
+        const std::uint32_t body = (mass[c.a] > 0.0f) ? c.a : c.b;
+        const std::uint32_t isl = body_island_[body];
+        contact_island_[k] = isl;
+        if (isl != npos) ++contact_start_[isl + 1];
+    }
+    for (std::uint32_t k = 0; k < islands; ++k) contact_start_[k + 1] += contact_start_[k];
+    resize_scratch(contacts_, contact_start_[islands]);
+    std::copy(contact_start_.begin(), contact_start_.end(), cursor_.begin());
+    for (std::size_t k = 0; k < contact_count; ++k) {
+        const std::uint32_t isl = contact_island_[k];
+        if (isl == npos) continue;
+        contacts_[cursor_[isl]++] = static_cast<std::uint32_t>(k);
+    }
+}
+
+} // namespace ape
@@ -0,0 +1,107 @@
+#pragma once
+
+// Bump allocator for buffers that live for one World::step. reset() at the
+// start of a step makes all of the previous step's memory reusable in O(1).
+// When a step asks for more than the arena holds, the arena moves to a new
+// block sized for everything requested so far in that step plus headroom; the
+// old block stays valid until the next reset() frees it. After the largest
+// step has been seen once, steps make no heap allocations at all.
+//
+// Only for trivially copyable, trivially destructible types: alloc() returns
+// uninitialized storage and nothing is destroyed on reset().
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <span>
+#include <type_traits>
+#include <vector>
+
+namespace ape {
+
+class FrameArena {
+public:
+    static constexpr std::size_t alignment = 64; // cache line; enough for every SIMD width
+
+    FrameArena() = default;
+    ~FrameArena() { release(); }
+    FrameArena(const FrameArena&) = delete;
+    FrameArena& operator=(const FrameArena&) = delete;
+
+    // Start a new frame. Invalidates every span handed out since the last reset.
+    void reset() {
+        for (std::byte* p : retired_) free_block(p);
+        retired_.clear();
+        used_ = 0;
+        requested_ = 0;
+    }
+
+    template <class T>
+    std::span<T> alloc(std::size_t count) {
+        static_assert(std::is_trivially_copyable_v<T> && std::is_trivially_destructible_v<T>);
+        static_assert(alignof(T) <= alignment);
+        if (count == 0) return {};
+        const std::size_t bytes = round_up(count * sizeof(T));
+        requested_ += bytes;
+        if (used_ + bytes > capacity_) grow();
+        std::byte* p = main_ + used_;
+        used_ += bytes;
+        return {reinterpret_cast<T*>(p), count};
+    }
+
+    // Like alloc(), with every element set to `value`
+    template <class T>
+    std::span<T> alloc(std::size_t count, const T& value) {
+        const std::span<T> s = alloc<T>(count);
+        for (T& v : s) v = value;
+        return s;
+    }
+
+    // Bytes held by the current block
+    std::size_t capacity() const { return capacity_; }
+
+    // Return all memory to the heap
+    void release() {
+        reset();
+        if (main_) free_block(main_);
+        main_ = nullptr;
+        capacity_ = 0;
+    }
+
+private:
+    static std::size_t round_up(std::size_t bytes) { return (bytes + alignment - 1) & ~(alignment - 1); }
+    static std::byte* allocate_block(std::size_t bytes) {
+        return static_cast<std::byte*>(::operator new(bytes, std::align_val_t{alignment}));
+    }
+    static void free_block(std::byte* p) { ::operator delete(p, std::align_val_t{alignment}); }
+
+    // Room for this frame's requests so far (the pending one included) in one
+    // block, so the same frame fits without growing next time
+    void grow() {
+        const std::size_t want = round_up(std::max(requested_ + requested_ / 2, capacity_ * 2));
+        std::byte* block = allocate_block(want);
+        if (main_) retired_.push_back(main_);
+        main_ = block;
+        capacity_ = want;
+        used_ = 0;
+    }
+
+    std::byte* main_{nullptr};
+    std::size_t capacity_{0};
+    std::size_t used_{0};      // bytes of main_ in use this frame
+    std::size_t requested_{0}; // bytes handed out this frame, all blocks
+    std::vector<std::byte*> retired_; // outgrown blocks still referenced this frame
+};
+
+// Resize a scratch vector kept by a component across steps. reserve() and
+// assign() allocate exactly the size asked for, and how resize() grows is up
+// to the library, so a count that creeps up from step to step could allocate
+// on every step; this grows the capacity by half at least.
+template <class T>
+void resize_scratch(std::vector<T>& v, std::size_t n) {
+    if (n > v.capacity()) v.reserve(std::max(n, v.capacity() + v.capacity() / 2));
+    v.resize(n);
+}
+
+} // namespace ape
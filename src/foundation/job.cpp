@@ -4,47 +4,136 @@ using namespace std;
 
 namespace ape {
 
+// Worker identity of the current thread (owner == nullptr for non-worker threads)
+static thread_local const JobSystem* tls_owner = nullptr;
+static thread_local unsigned tls_index = 0;
+
+namespace {
+struct SpinGuard {
+    explicit SpinGuard(atomic_flag& f) : flag(f) {
+        while (flag.test_and_set(memory_order_acquire)) this_thread::yield();
+    }
+    ~SpinGuard() { flag.clear(memory_order_release); }
+    atomic_flag& flag;
+};
+}
+
+bool JobSystem::WorkQueue::push(const Job& job) {
+    SpinGuard g(lock);
+    if (tail - head >= queue_capacity) return false;
+    ring[tail % queue_capacity] = job;
+    ++tail;
+    return true;
+}
+
+bool JobSystem::WorkQueue::pop(Job& out) {
+    SpinGuard g(lock);
+    if (tail == head) return false;
+    --tail;
+    out = ring[tail % queue_capacity];
+    return true;
+}
+
+bool JobSystem::WorkQueue::steal(Job& out) {
+    SpinGuard g(lock);
+    if (tail == head) return false;
+    out = ring[head % queue_capacity];
+    ++head;
+    return true;
+}
+
 JobSystem::JobSystem(unsigned workers) {
     if (workers == 0) workers = 1;
+    worker_count_ = workers;
+    queue_count_ = workers + 1;
+    queues_ = make_unique<WorkQueue[]>(queue_count_);
     threads_.reserve(workers);
     for (unsigned i=0;i<workers;i++) {
-        threads_.emplace_back([this]{ worker_loop(); });
+        threads_.emplace_back([this, i]{ worker_loop(i); });
     }
 }
 
 JobSystem::~JobSystem() {
-    quit_.store(true, memory_order_relaxed);
-    cv_.notify_all();
+    // Run whatever is still queued so jobs (and their counters) are never dropped
+    wait_idle();
+    {
+        lock_guard<mutex> lock(sleep_mtx_);
+        quit_.store(true, memory_order_relaxed);
+    }
+    sleep_cv_.notify_all();
     for (auto& t : threads_) if (t.joinable()) t.join();
 }
 
-void JobSystem::enqueue(function<void()> job) {
-    {
-        lock_guard<mutex> lock(mtx_);
-        q_.push(move(job));
+void JobSystem::submit(const Job& job) {
+    if (JobCounter* c = job.counter()) c->pending_.fetch_add(1, memory_order_relaxed);
+    outstanding_.fetch_add(1, memory_order_relaxed);
+
+    const unsigned workers = worker_count_;
+    const unsigned target = (tls_owner == this) ? tls_index : workers;
+    queued_.fetch_add(1, memory_order_seq_cst);
+    if (!queues_[target].push(job)) {
+        // Deque full: run inline rather than allocate
+        queued_.fetch_sub(1, memory_order_relaxed);
+        Job copy = job;
+        execute(copy);
+        return;
+    }
+    if (sleepers_.load(memory_order_seq_cst) > 0) {
+        lock_guard<mutex> lock(sleep_mtx_);
+        sleep_cv_.notify_one();
+    }
+}
+
+void JobSystem::execute(Job& job) {
+    job.run();
+    if (JobCounter* c = job.counter()) c->pending_.fetch_sub(1, memory_order_acq_rel);
+    outstanding_.fetch_sub(1, memory_order_acq_rel);
+}
+
+bool JobSystem::try_run_one(unsigned self) {
+    const unsigned workers = worker_count_;
+    Job job;
+    bool found = false;
+    if (self < workers) found = queues_[self].pop(job);
+    if (!found) found = queues_[workers].steal(job); // injection queue is FIFO
+    for (unsigned k = 1; !found && k <= workers; ++k) {
+        const unsigned victim = (self + k) % queue_count_;
+        if (victim == workers || victim == self) continue;
+        found = queues_[victim].steal(job);
+    }
+    if (!found) return false;
+    queued_.fetch_sub(1, memory_order_relaxed);
+    execute(job);
+    return true;
+}
+
+void JobSystem::wait(const JobCounter& counter) {
+    const unsigned self = (tls_owner == this) ? tls_index : worker_count_;
+    while (!counter.done()) {
+        if (!try_run_one(self)) this_thread::yield();
     }
-    cv_.notify_one();
 }
 
 void JobSystem::wait_idle() {
-    unique_lock<mutex> lock(mtx_);
-    cv_.wait(lock, [this]{ return q_.empty() && active_.load(memory_order_relaxed) == 0; });
+    const unsigned self = (tls_owner == this) ? tls_index : worker_count_;
+    while (outstanding_.load(memory_order_acquire) != 0) {
+        if (!try_run_one(self)) this_thread::yield();
+    }
 }
 
-void JobSystem::worker_loop() {
+void JobSystem::worker_loop(unsigned index) {
+    tls_owner = this;
+    tls_index = index;
+    constexpr int spin_limit = 64;
+    int idle_spins = 0;
     while (!quit_.load(memory_order_relaxed)) {
-        function<void()> job;
-        {
-            unique_lock<mutex> lock(mtx_);
-            cv_.wait(lock, [this]{ return quit_.load(memory_order_relaxed) || !q_.empty(); });
-            if (quit_.load(memory_order_relaxed)) return;
-            job = move(q_.front());
-            q_.pop();
-            active_.fetch_add(1, memory_order_relaxed);
-        }
-        job();
-        active_.fetch_sub(1, memory_order_relaxed);
-        cv_.notify_all();
+        if (try_run_one(index)) { idle_spins = 0; continue; }
+        if (++idle_spins < spin_limit) { this_thread::yield(); continue; }
+        idle_spins = 0;
+        unique_lock<mutex> lock(sleep_mtx_);
+        sleepers_.fetch_add(1, memory_order_seq_cst);
+        sleep_cv_.wait(lock, [this]{ return quit_.load(memory_order_relaxed) || queued_.load(memory_order_seq_cst) > 0; });
+        sleepers_.fetch_sub(1, memory_order_seq_cst);
     }
 }
 
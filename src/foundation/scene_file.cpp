@@ -0,0 +1,155 @@
+#include "ape/scene_file.h"
+#include <bit>
+#include <cstddef>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ape {
+
+namespace {
+
+struct SceneHeader {
+    char magic[8];            // "APESCENE"
+    std::uint32_t version;
+    std::uint32_t endian;     // scene_endian as written by the saving machine
+    std::uint32_t index_bits;
+    std::uint32_t reserved;
+    std::uint64_t body_count;
+    std::uint64_t slot_count;
+    std::uint64_t payload_offset; // from the start of the file, 8-byte aligned
+    std::uint64_t payload_bytes;
+    std::uint64_t reserved2;
+};
+static_assert(sizeof(SceneHeader) == 64);
+
+constexpr char scene_magic[8] = {'A', 'P', 'E', 'S', 'C', 'E', 'N', 'E'};
+constexpr std::uint32_t scene_version = 3; // 2: snapshot payload with collision filters, 3: sleep rings
+constexpr std::uint32_t scene_endian = 0x01020304u;
+
+bool header_ok(const SceneHeader& h, std::uint64_t file_size) {
+    return std::memcmp(h.magic, scene_magic, sizeof(scene_magic)) == 0 && h.version == scene_version &&
+           h.endian == scene_endian && h.payload_offset >= sizeof(SceneHeader) && h.payload_offset % 8 == 0 &&
+           h.payload_offset <= file_size && h.payload_bytes == file_size - h.payload_offset;
+}
+
+// Read-only view of a whole file: memory-mapped where available
+class MappedFile {
+public:
+    explicit MappedFile(const char* path) {
+#if defined(_WIN32)
+        file_ = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file_ == INVALID_HANDLE_VALUE) return;
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file_, &size) || size.QuadPart == 0) return;
+        mapping_ = CreateFileMappingA(file_, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping_) return;
+        data_ = static_cast<const std::byte*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        if (data_) size_ = static_cast<std::size_t>(size.QuadPart);
+#else
+        const int fd = ::open(path, O_RDONLY);
+        if (fd < 0) return;
+        struct stat st;
+        if (::fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* p = ::mmap(nullptr, static_cast<std::size_t>(st.st_size), PROT_READ, MAP_PRIVATE, fd, 0);
+            if (p != MAP_FAILED) {
+                // One front-to-back pass: let the kernel read ahead
+                ::madvise(p, static_cast<std::size_t>(st.st_size), MADV_SEQUENTIAL);
+                data_ = static_cast<const std::byte*>(p);
+                size_ = static_cast<std::size_t>(st.st_size);
+            }
+        }
+        ::close(fd); // the mapping keeps the file referenced
+#endif
+    }
+    ~MappedFile() {
+#if defined(_WIN32)
+        if (data_) UnmapViewOfFile(data_);
+        if (mapping_) CloseHandle(mapping_);
+        if (file_ != INVALID_HANDLE_VALUE) CloseHandle(file_);
+#else
+        if (data_) ::munmap(const_cast<std::byte*>(data_), size_);
+#endif
+    }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    std::span<const std::byte> bytes() const { return {data_, size_}; }
+
+private:
+    const std::byte* data_{nullptr};
+    std::size_t size_{0};
+#if defined(_WIN32)
+    HANDLE file_{INVALID_HANDLE_VALUE};
+    HANDLE mapping_{nullptr};
+#endif
+};
+
+} // namespace
+
+bool saveScene(const World& world, const char* path) {
+    if (!path) return false;
+    // Header and payload in one buffer so the file is written with one call
+    const std::size_t payload = world.snapshotSize();
+    std::vector<std::byte> buf(sizeof(SceneHeader) + payload);
+    SceneHeader h{};
+    std::memcpy(h.magic, scene_magic, sizeof(scene_magic));
+    h.version = scene_version;
+    h.endian = scene_endian;
+    h.index_bits = static_cast<std::uint32_t>(std::bit_width(world.maxBodies())); // maxBodies = 2^bits - 1
+    h.body_count = world.bodyCount();
+    h.slot_count = world.bodies().alive.size();
+    h.payload_offset = sizeof(SceneHeader);
+    h.payload_bytes = payload;
+    if (world.saveSnapshot(std::span<std::byte>(buf).subspan(sizeof(SceneHeader))) != payload) return false;
+    std::memcpy(buf.data(), &h, sizeof(h));
+
+    std::FILE* f = std::fopen(path, "wb");
+    if (!f) return false;
+    const bool written = std::fwrite(buf.data(), 1, buf.size(), f) == buf.size();
+    return std::fclose(f) == 0 && written;
+}
+
+bool loadScene(World& world, const char* path) {
+    if (!path) return false;
+    const MappedFile file(path);
+    const auto bytes = file.bytes();
+    SceneHeader h;
+    if (bytes.size() < sizeof(h)) return false;
+    std::memcpy(&h, bytes.data(), sizeof(h));
+    if (!header_ok(h, bytes.size())) return false;
+    return world.restoreSnapshot(bytes.subspan(static_cast<std::size_t>(h.payload_offset)));
+}
+
+bool readSceneInfo(const char* path, SceneInfo& out) {
+    if (!path) return false;
+    std::error_code ec;
+    const std::uintmax_t size = std::filesystem::file_size(path, ec);
+    if (ec) return false;
+    std::FILE* f = std::fopen(path, "rb");
+    if (!f) return false;
+    SceneHeader h;
+    const bool read = std::fread(&h, sizeof(h), 1, f) == 1;
+    std::fclose(f);
+    if (!read || !header_ok(h, size)) return false;
+    out.version = h.version;
+    out.index_bits = h.index_bits;
+    out.body_count = h.body_count;
+    out.slot_count = h.slot_count;
+    return true;
+}
+
+} // namespace ape
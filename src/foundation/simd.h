@@ -0,0 +1,159 @@
+#pragma once
+
+// Internal lane-wise float vector used by the SIMD kernels (contact solver,
+// narrowphase). Kernels are written once against these helpers and compile to
+// AVX2 (8 lanes), SSE or WebAssembly SIMD128 (4 lanes) or a one-lane scalar
+// fallback depending on the target flags (APE_SIMD in CMake, -msimd128 for the
+// threaded WASM build). Masks are all-ones / all-zeros lanes of
+// the same type; bits() packs them into an integer, lane l in bit l.
+//
+// Private to src/: every translation unit including this must be built with
+// the same APE_SIMD flags.
+
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include "ape/ape.h"
+
+#if !defined(APE_SIMD_SCALAR) && defined(__AVX2__)
+#define APE_SIMD_AVX2 1
+#include <immintrin.h>
+#elif !defined(APE_SIMD_SCALAR) && defined(__wasm_simd128__)
+#define APE_SIMD_WASM 1
+#include <wasm_simd128.h>
+#elif !defined(APE_SIMD_SCALAR) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define APE_SIMD_SSE 1
+#include <emmintrin.h>
+#endif
+
+namespace ape::simd {
+
+#if defined(APE_SIMD_AVX2)
+constexpr std::size_t W = 8;
+using vf = __m256;
+inline vf load(const float* p) { return _mm256_loadu_ps(p); }
+inline void store(float* p, vf v) { _mm256_storeu_ps(p, v); }
+inline vf set1(float x) { return _mm256_set1_ps(x); }
+inline vf add(vf a, vf b) { return _mm256_add_ps(a, b); }
+inline vf sub(vf a, vf b) { return _mm256_sub_ps(a, b); }
+inline vf mul(vf a, vf b) { return _mm256_mul_ps(a, b); }
+inline vf div(vf a, vf b) { return _mm256_div_ps(a, b); }
+inline vf sqrt(vf a) { return _mm256_sqrt_ps(a); }
+inline vf min(vf a, vf b) { return _mm256_min_ps(a, b); }
+inline vf max(vf a, vf b) { return _mm256_max_ps(a, b); }
+inline vf neg(vf a) { return _mm256_xor_ps(a, _mm256_set1_ps(-0.0f)); }
+inline vf abs(vf a) { return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a); }
+inline vf gt(vf a, vf b) { return _mm256_cmp_ps(a, b, _CMP_GT_OQ); }
+inline vf lt(vf a, vf b) { return _mm256_cmp_ps(a, b, _CMP_LT_OQ); }
+inline vf mask_and(vf a, vf b) { return _mm256_and_ps(a, b); }
+inline vf mask_andnot(vf a, vf b) { return _mm256_andnot_ps(a, b); } // !a & b
+inline vf select(vf m, vf a, vf b) { return _mm256_blendv_ps(b, a, m); }
+inline unsigned bits(vf m) { return static_cast<unsigned>(_mm256_movemask_ps(m)); }
+inline vf gather1(const float* base, const std::uint32_t* idx) {
+    return _mm256_i32gather_ps(base, _mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx)), 4);
+}
+// Hardware gather of x, y, z from an AoS Vec3 array (3 floats per element)
+inline void gather3(const Vec3* v, const std::uint32_t* idx, vf& x, vf& y, vf& z) {
+    const float* base = &v[0].x;
+    const __m256i i3 = _mm256_mullo_epi32(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(idx)), _mm256_set1_epi32(3));
+    x = _mm256_i32gather_ps(base, i3, 4);
+    y = _mm256_i32gather_ps(base + 1, i3, 4);
+    z = _mm256_i32gather_ps(base + 2, i3, 4);
+}
+#elif defined(APE_SIMD_SSE)
+constexpr std::size_t W = 4;
+using vf = __m128;
+inline vf load(const float* p) { return _mm_loadu_ps(p); }
+inline void store(float* p, vf v) { _mm_storeu_ps(p, v); }
+inline vf set1(float x) { return _mm_set1_ps(x); }
+inline vf add(vf a, vf b) { return _mm_add_ps(a, b); }
+inline vf sub(vf a, vf b) { return _mm_sub_ps(a, b); }
+inline vf mul(vf a, vf b) { return _mm_mul_ps(a, b); }
+inline vf div(vf a, vf b) { return _mm_div_ps(a, b); }
+inline vf sqrt(vf a) { return _mm_sqrt_ps(a); }
+inline vf min(vf a, vf b) { return _mm_min_ps(a, b); }
+inline vf max(vf a, vf b) { return _mm_max_ps(a, b); }
+inline vf neg(vf a) { return _mm_xor_ps(a, _mm_set1_ps(-0.0f)); }
+inline vf abs(vf a) { return _mm_andnot_ps(_mm_set1_ps(-0.0f), a); }
+inline vf gt(vf a, vf b) { return _mm_cmpgt_ps(a, b); }
+inline vf lt(vf a, vf b) { return _mm_cmplt_ps(a, b); }
+inline vf mask_and(vf a, vf b) { return _mm_and_ps(a, b); }
+inline vf mask_andnot(vf a, vf b) { return _mm_andnot_ps(a, b); }
+inline vf select(vf m, vf a, vf b) { return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b)); }
+inline unsigned bits(vf m) { return static_cast<unsigned>(_mm_movemask_ps(m)); }
+inline vf gather1(const float* base, const std::uint32_t* idx) {
+    return _mm_setr_ps(base[idx[0]], base[idx[1]], base[idx[2]], base[idx[3]]);
+}
+inline void gather3(const Vec3* v, const std::uint32_t* idx, vf& x, vf& y, vf& z) {
+    const Vec3& v0 = v[idx[0]]; const Vec3& v1 = v[idx[1]];
+    const Vec3& v2 = v[idx[2]]; const Vec3& v3 = v[idx[3]];
+    x = _mm_setr_ps(v0.x, v1.x, v2.x, v3.x);
+    y = _mm_setr_ps(v0.y, v1.y, v2.y, v3.y);
+    z = _mm_setr_ps(v0.z, v1.z, v2.z, v3.z);
+}
+#elif defined(APE_SIMD_WASM)
+constexpr std::size_t W = 4;
+using vf = v128_t;
+inline vf load(const float* p) { return wasm_v128_load(p); }
+inline void store(float* p, vf v) { wasm_v128_store(p, v); }
+inline vf set1(float x) { return wasm_f32x4_splat(x); }
+inline vf add(vf a, vf b) { return wasm_f32x4_add(a, b); }
+inline vf sub(vf a, vf b) { return wasm_f32x4_sub(a, b); }
+inline vf mul(vf a, vf b) { return wasm_f32x4_mul(a, b); }
+inline vf div(vf a, vf b) { return wasm_f32x4_div(a, b); }
+inline vf sqrt(vf a) { return wasm_f32x4_sqrt(a); }
+// pmin/pmax have the same operand order semantics as the scalar min/max below
+inline vf min(vf a, vf b) { return wasm_f32x4_pmin(a, b); }
+inline vf max(vf a, vf b) { return wasm_f32x4_pmax(a, b); }
+inline vf neg(vf a) { return wasm_f32x4_neg(a); }
+inline vf abs(vf a) { return wasm_f32x4_abs(a); }
+inline vf gt(vf a, vf b) { return wasm_f32x4_gt(a, b); }
+inline vf lt(vf a, vf b) { return wasm_f32x4_lt(a, b); }
+inline vf mask_and(vf a, vf b) { return wasm_v128_and(a, b); }
+inline vf mask_andnot(vf a, vf b) { return wasm_v128_andnot(b, a); }
+inline vf select(vf m, vf a, vf b) { return wasm_v128_bitselect(a, b, m); }
+inline unsigned bits(vf m) { return static_cast<unsigned>(wasm_i32x4_bitmask(m)); }
+inline vf gather1(const float* base, const std::uint32_t* idx) {
+    return wasm_f32x4_make(base[idx[0]], base[idx[1]], base[idx[2]], base[idx[3]]);
+}
+inline void gather3(const Vec3* v, const std::uint32_t* idx, vf& x, vf& y, vf& z) {
+    const Vec3& v0 = v[idx[0]]; const Vec3& v1 = v[idx[1]];
+    const Vec3& v2 = v[idx[2]]; const Vec3& v3 = v[idx[3]];
+    x = wasm_f32x4_make(v0.x, v1.x, v2.x, v3.x);
+    y = wasm_f32x4_make(v0.y, v1.y, v2.y, v3.y);
+    z = wasm_f32x4_make(v0.z, v1.z, v2.z, v3.z);
+}
+#else
+// Scalar fallback: one lane, masks are 0/1
+constexpr std::size_t W = 1;
+struct vf { float v; };
+inline vf load(const float* p) { return {*p}; }
+inline void store(float* p, vf v) { *p = v.v; }
+inline vf set1(float x) { return {x}; }
+inline vf add(vf a, vf b) { return {a.v + b.v}; }
+inline vf sub(vf a, vf b) { return {a.v - b.v}; }
+inline vf mul(vf a, vf b) { return {a.v * b.v}; }
+inline vf div(vf a, vf b) { return {a.v / b.v}; }
+inline vf sqrt(vf a) { return {std::sqrt(a.v)}; }
+inline vf min(vf a, vf b) { return {b.v < a.v ? b.v : a.v}; }
+inline vf max(vf a, vf b) { return {b.v > a.v ? b.v : a.v}; }
+inline vf neg(vf a) { return {-a.v}; }
+inline vf abs(vf a) { return {std::fabs(a.v)}; }
+inline vf gt(vf a, vf b) { return {a.v > b.v ? 1.0f : 0.0f}; }
+inline vf lt(vf a, vf b) { return {a.v < b.v ? 1.0f : 0.0f}; }
+inline vf mask_and(vf a, vf b) { return {(a.v != 0.0f && b.v != 0.0f) ? 1.0f : 0.0f}; }
+inline vf mask_andnot(vf a, vf b) { return {(a.v == 0.0f && b.v != 0.0f) ? 1.0f : 0.0f}; }
+inline vf select(vf m, vf a, vf b) { return m.v != 0.0f ? a : b; }
+inline unsigned bits(vf m) { return m.v != 0.0f ? 1u : 0u; }
+inline vf gather1(const float* base, const std::uint32_t* idx) { return {base[idx[0]]}; }
+inline void gather3(const Vec3* v, const std::uint32_t* idx, vf& x, vf& y, vf& z) {
+    const Vec3 e = v[idx[0]];
+    x = {e.x}; y = {e.y}; z = {e.z};
+}
+#endif
+
+inline vf dot(vf ax, vf ay, vf az, vf bx, vf by, vf bz) {
+    return add(add(mul(ax, bx), mul(ay, by)), mul(az, bz));
+}
+
+} // namespace ape::simd
@@ -0,0 +1,65 @@
+#include "ape/ape.h"
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+int main(){
+    using namespace ape;
+
+    // Holes from destroyed bodies: counts follow creates/destroys, survivors keep stepping
+    {
+        World w;
+        w.setGravity({0, 0, 0});
+        std::vector<std::uint32_t> ids;
+        RigidBodyDesc d{};
+        d.velocity = {1, 0, 0};
+        for (int i = 0; i < 200; ++i) {
+            d.position = {0, 0, 3.0f * static_cast<float>(i)};
+            ids.push_back(w.createRigidBody(d));
+        }
+        for (int i = 0; i < 200; i += 2) w.destroyRigidBody(ids[i]);
+        w.destroyRigidBody(ids[0]); // double destroy is a no-op
+        assert(w.bodyCount() == 100);
+        for (int i = 0; i < 10; ++i) ids[2 * i] = w.createRigidBody(d);
+        assert(w.bodyCount() == 110);
+        w.step(0.5f);
+        for (int i = 1; i < 200; i += 2) assert(w.getPosition(ids[i]).x == 0.5f);
+        for (int i = 0; i < 10; ++i) assert(w.getPosition(ids[2 * i]).x == 0.5f);
+    }
+
+    // A sleeping body keeps its broadphase box and is woken by an incoming body
+    {
+        World w;
+        w.setGravity({0, 0, 0});
+        RigidBodyDesc d{};
+        d.position = {0, 0, 0};
+        [[maybe_unused]] const auto resting = w.createRigidBody(d);
+        for (int i = 0; i < 120; ++i) w.step(1.0f/120.0f); // falls asleep after 0.5 s
+        assert(w.getVelocity(resting).x == 0.0f);
+
+        d.position = {-3, 0, 0};
+        d.velocity = {4, 0, 0};
+        w.createRigidBody(d);
+        for (int i = 0; i < 120; ++i) w.step(1.0f/120.0f);
+        assert(w.getPosition(resting).x > 0.1f);
+    }
+
+    // A destroyed sleeping body no longer collides
+    {
+        World w;
+        w.setGravity({0, 0, 0});
+        RigidBodyDesc d{};
+        d.position = {0, 0, 0};
+        const auto resting = w.createRigidBody(d);
+        d.position = {-20, 0, 0};
+        d.velocity = {4, 0, 0};
+        [[maybe_unused]] const auto mover = w.createRigidBody(d);
+        for (int i = 0; i < 120; ++i) w.step(1.0f/120.0f);
+        w.destroyRigidBody(resting);
+        for (int i = 0; i < 720; ++i) w.step(1.0f/120.0f);
+        assert(w.getPosition(mover).x > 5.0f);
+        assert(w.getVelocity(mover).x == 4.0f);
+        assert(w.bodyCount() == 1);
+    }
+    return 0;
+}
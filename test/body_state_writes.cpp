@@ -0,0 +1,27 @@
+#include "ape/ape.h"
+#include <cassert>
+
+int main(){
+    ape::World w;
+    w.setGravity({0, 0, 0});
+
+    // A slow body falls asleep (velocity zeroed)
+    ape::RigidBodyDesc d{};
+    d.velocity = {0.005f, 0, 0};
+    auto id = w.createRigidBody(d);
+    for (int i = 0; i < 120; i++) w.step(1.0f/120.0f);
+    auto v = w.getVelocity(id);
+    assert(v.x == 0.0f && v.y == 0.0f && v.z == 0.0f);
+
+    // Setting velocity wakes it: the next step keeps the written velocity
+    w.setVelocity(id, {1.0f, 0, 0});
+    w.step(1.0f/120.0f);
+    v = w.getVelocity(id);
+    assert(v.x == 1.0f);
+
+    // Setting position takes effect immediately
+    w.setPosition(id, {-10.0f, 0, 0});
+    assert(w.getPosition(id).x == -10.0f);
+
+    return 0;
+}
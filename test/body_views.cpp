@@ -0,0 +1,43 @@
+#include "ape/ape.h"
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+int main(){
+    using namespace ape;
+    World w;
+    w.setGravity({0, 0, 0});
+    std::vector<std::uint32_t> ids;
+    RigidBodyDesc d{};
+    for (int i = 0; i < 50; ++i) {
+        d.position = {3.0f * static_cast<float>(i), 0, 0};
+        d.velocity = {0, static_cast<float>(i), 0};
+        ids.push_back(w.createRigidBody(d));
+    }
+    w.destroyRigidBody(ids[10]);
+    w.destroyRigidBody(ids[20]);
+    w.step(0.25f);
+
+    // Slot views agree with per-handle getters
+    const BodyView v = w.bodies();
+    assert(v.positions.size() == 50 && v.velocities.size() == 50 && v.alive.size() == 50 && v.awake.size() == 50);
+    assert(v.live_slots.size() == w.bodyCount());
+    for (int i = 0; i < 50; ++i) {
+        [[maybe_unused]] const std::uint32_t slot = w.slotOf(ids[i]);
+        if (i == 10 || i == 20) {
+            assert(slot == UINT32_MAX && !v.alive[static_cast<std::size_t>(i)]);
+            assert(w.handleAt(static_cast<std::uint32_t>(i)) == UINT32_MAX);
+            continue;
+        }
+        assert(v.alive[slot] == 1 && v.awake[slot] == 1);
+        assert(w.handleAt(slot) == ids[i]);
+        [[maybe_unused]] const Vec3 p = w.getPosition(ids[i]);
+        assert(v.positions[slot].x == p.x && v.positions[slot].y == p.y && v.positions[slot].z == p.z);
+        assert(v.velocities[slot].y == w.getVelocity(ids[i]).y);
+    }
+    std::size_t live = 0;
+    for ([[maybe_unused]] std::uint32_t s : v.live_slots) { assert(v.alive[s]); ++live; }
+    assert(live == 48);
+    assert(w.handleAt(1000) == UINT32_MAX);
+    return 0;
+}
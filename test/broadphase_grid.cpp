@@ -0,0 +1,60 @@
+#include "ape/ape.h"
+#include "ape/broadphase.h"
+#include "broadphase_test_util.h"
+#include <cassert>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+int main(){
+    using namespace ape;
+    TestRandom rnd{4242u};
+
+    // Similar-sized spheres scattered in a volume, including negative coordinates
+    std::vector<AABB> boxes;
+    for (int i = 0; i < 600; ++i) {
+        const float x = rnd() * 20.0f - 10.0f, y = rnd() * 8.0f - 4.0f, z = rnd() * 20.0f - 10.0f;
+        const float r = 0.4f + rnd() * 0.2f;
+        boxes.push_back(AABB{x - r, y - r, z - r, x + r, y + r, z + r});
+    }
+    boxes[5] = aabb_empty();
+    // Oversized floor and wall span many cells and overlap each other
+    boxes.push_back(AABB{-20, -5, -20, 20, -3.5f, 20});
+    boxes.push_back(AABB{-20, -5, -20, -9, 5, 20});
+
+    SpatialHashGrid grid;
+    std::vector<Pair> pairs, naive;
+    grid.update(boxes.data(), boxes.size(), pairs);
+    broadphase_naive(boxes.data(), boxes.size(), naive);
+    std::sort(naive.begin(), naive.end(), pair_less);
+    assert(grid.cellSize() > 0.8f && grid.cellSize() < 1.2f);
+    assert(!pairs.empty());
+    assert(same_pairs(pairs, naive)); // deduplicated, (a, b) ordered
+
+    // Fixed cell sizes far from the box size still give the exact pair set
+    for (float cell : {0.25f, 7.0f}) {
+        SpatialHashGrid fixed(cell);
+        fixed.update(boxes.data(), boxes.size(), pairs);
+        assert(same_pairs(pairs, naive));
+    }
+
+    // World results do not depend on the backend
+    auto run = [](BroadphaseType type) {
+        World w;
+        w.setBroadphase(type);
+        RigidBodyDesc d{};
+        std::vector<std::uint32_t> ids;
+        for (int i = 0; i < 80; ++i) {
+            d.position = {0.7f * static_cast<float>(i % 4), 0.9f * static_cast<float>(i / 4), 0.3f * static_cast<float>(i % 3)};
+            ids.push_back(w.createRigidBody(d));
+        }
+        for (int i = 0; i < 120; ++i) w.step(1.0f/120.0f);
+        std::vector<Vec3> out;
+        for (auto id : ids) out.push_back(w.getPosition(id));
+        return out;
+    };
+    const auto a = run(BroadphaseType::SweepAndPrune);
+    const auto b = run(BroadphaseType::SpatialGrid);
+    for (std::size_t i = 0; i < a.size(); ++i) assert(a[i].x == b[i].x && a[i].y == b[i].y && a[i].z == b[i].z);
+    return 0;
+}
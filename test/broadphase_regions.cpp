@@ -0,0 +1,85 @@
+#include "ape/ape.h"
+#include "ape/broadphase.h"
+#include "ape/job.h"
+#include "broadphase_test_util.h"
+#include <cassert>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+int main(){
+    using namespace ape;
+    TestRandom rnd{777u};
+
+    // A wide, flat world: small boxes, some long ones straddling many regions,
+    // unoccupied slots, and a box far outside the rest
+    std::vector<AABB> boxes;
+    for (int i = 0; i < 3000; ++i) {
+        const float x = rnd() * 200.0f - 100.0f, y = rnd() * 4.0f, z = rnd() * 60.0f - 30.0f;
+        const float r = 0.3f + rnd() * 0.5f;
+        boxes.push_back(AABB{x - r, y - r, z - r, x + r, y + r, z + r});
+    }
+    for (int i = 0; i < 20; ++i) {
+        const float x = rnd() * 200.0f - 100.0f, z = rnd() * 60.0f - 30.0f;
+        boxes.push_back(AABB{x, 0, z, x + 40.0f, 1, z + 3.0f}); // walls
+    }
+    boxes[17] = aabb_empty();
+    boxes[900] = aabb_empty();
+    boxes.push_back(AABB{1000, 0, 1000, 1001, 1, 1001});
+
+    std::vector<Pair> naive;
+    broadphase_naive(boxes.data(), boxes.size(), naive);
+    std::sort(naive.begin(), naive.end(), pair_less);
+    assert(naive.size() > 1000);
+
+    // Any layout and thread count gives the exact, deduplicated, (a, b) ordered set
+    JobSystem jobs(4);
+    std::vector<Pair> pairs;
+    RegionBroadphase automatic;
+    automatic.update(boxes.data(), boxes.size(), pairs);
+    assert(automatic.regionsX() * automatic.regionsZ() > 1);
+    assert(same_pairs(pairs, naive));
+    automatic.update(boxes.data(), boxes.size(), pairs, &jobs);
+    assert(same_pairs(pairs, naive));
+    const std::uint32_t layouts[][2] = {{1, 1}, {8, 1}, {1, 8}, {7, 3}, {64, 64}};
+    for (const auto& l : layouts) {
+        RegionBroadphase fixed(l[0], l[1]);
+        fixed.update(boxes.data(), boxes.size(), pairs, &jobs);
+        assert(fixed.regionsX() == l[0] && fixed.regionsZ() == l[1]);
+        assert(same_pairs(pairs, naive));
+    }
+
+    // Degenerate inputs
+    RegionBroadphase bp;
+    bp.update(boxes.data(), 1, pairs);
+    assert(pairs.empty());
+    const AABB column[2] = {{0, 0, 0, 0, 1, 0}, {0, 0.5f, 0, 0, 2, 0}}; // zero X/Z extent
+    bp.update(column, 2, pairs, &jobs);
+    assert(pairs.size() == 1 && pairs[0].a == 0 && pairs[0].b == 1);
+
+    // World results do not depend on the backend or the thread count
+    auto run = [](BroadphaseType type, unsigned threads) {
+        World w;
+        w.setBroadphase(type);
+        w.setThreadCount(threads);
+        RigidBodyDesc d{};
+        std::vector<std::uint32_t> ids;
+        for (int i = 0; i < 2000; ++i) {
+            d.position = {0.95f * static_cast<float>(i % 100), 0.9f * static_cast<float>(i / 400),
+                          0.95f * static_cast<float>((i / 100) % 4)};
+            ids.push_back(w.createRigidBody(d));
+        }
+        for (int i = 0; i < 30; ++i) w.step(1.0f/120.0f);
+        std::vector<Vec3> out;
+        for (auto id : ids) out.push_back(w.getPosition(id));
+        return out;
+    };
+    const auto a = run(BroadphaseType::SweepAndPrune, 1);
+    const auto b = run(BroadphaseType::Regions, 1);
+    const auto c = run(BroadphaseType::Regions, 4);
+    for (std::size_t i = 0; i < a.size(); ++i) {
+        assert(a[i].x == b[i].x && a[i].y == b[i].y && a[i].z == b[i].z);
+        assert(a[i].x == c[i].x && a[i].y == c[i].y && a[i].z == c[i].z);
+    }
+    return 0;
+}
@@ -0,0 +1,24 @@
+#pragma once
+
+// Helpers shared by the broadphase tests
+
+#include "ape/broadphase.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Same pairs in the same order
+inline bool same_pairs(const std::vector<ape::Pair>& x, const std::vector<ape::Pair>& y) {
+    if (x.size() != y.size()) return false;
+    for (std::size_t i = 0; i < x.size(); ++i) if (x[i].a != y[i].a || x[i].b != y[i].b) return false;
+    return true;
+}
+
+// Deterministic pseudo-random floats in [0, 1) (LCG), so every run tests the same boxes
+struct TestRandom {
+    std::uint32_t seed;
+    float operator()() {
+        seed = seed * 1664525u + 1013904223u;
+        return static_cast<float>(seed >> 8) / 16777216.0f;
+    }
+};
@@ -0,0 +1,72 @@
+#include "ape/ape.h"
+#include "ape/dynamic_tree.h"
+#include "broadphase_test_util.h"
+#include <cassert>
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+int main(){
+    using namespace ape;
+    TestRandom rnd{777u};
+
+    // Bodies lined up along Z share one X range: worst case for X-axis SAP
+    std::vector<AABB> boxes(400);
+    std::vector<float> cz(boxes.size()), cy(boxes.size()), vz(boxes.size());
+    for (std::size_t i = 0; i < boxes.size(); ++i) {
+        cz[i] = static_cast<float>(i) * 0.9f; cy[i] = rnd() * 2.0f; vz[i] = (rnd() - 0.5f) * 0.3f;
+    }
+
+    DynamicTreeBroadphase bp(0.1f);
+    SweepAndPrune sap;
+    std::vector<Pair> tree_pairs, sap_pairs, naive;
+    for (int frame = 0; frame < 40; ++frame) {
+        for (std::size_t i = 0; i < boxes.size(); ++i) {
+            cz[i] += vz[i];
+            boxes[i] = AABB{-0.5f, cy[i] - 0.5f, cz[i] - 0.5f, 0.5f, cy[i] + 0.5f, cz[i] + 0.5f};
+        }
+        if (frame >= 10) boxes[3] = aabb_empty();   // proxy removed
+        if (frame >= 20) boxes.resize(350);         // trailing indices dropped
+        bp.update(boxes.data(), boxes.size(), tree_pairs);
+        sap.update(boxes.data(), boxes.size(), sap_pairs);
+        broadphase_naive(boxes.data(), boxes.size(), naive);
+        std::sort(naive.begin(), naive.end(), pair_less);
+        assert(same_pairs(tree_pairs, naive));
+        assert(same_pairs(tree_pairs, sap_pairs));
+        assert(bp.tree().validate());
+    }
+    assert(bp.tree().proxyCount() == 349);
+
+    // Rotations keep the tree shallow even for sorted insertion order
+    DynamicTree tree(0.0f);
+    for (std::uint32_t i = 0; i < 1024; ++i) {
+        const float x = static_cast<float>(i);
+        tree.createProxy(AABB{x, 0, 0, x + 0.5f, 0.5f, 0.5f}, i);
+    }
+    assert(tree.validate());
+    assert(tree.height() <= 20);
+    int hits = 0;
+    tree.query(AABB{10.2f, 0, 0, 12.1f, 1, 1}, [&](std::uint32_t){ ++hits; });
+    assert(hits == 3); // boxes 10, 11, 12
+
+    // World results do not depend on the backend
+    auto run = [](BroadphaseType type) {
+        World w;
+        w.setBroadphase(type);
+        assert(w.broadphase() == type);
+        RigidBodyDesc d{};
+        std::vector<std::uint32_t> ids;
+        for (int i = 0; i < 60; ++i) {
+            d.position = {0.1f * static_cast<float>(i % 3), 0.8f * static_cast<float>(i), 0.2f * static_cast<float>(i % 5)};
+            ids.push_back(w.createRigidBody(d));
+        }
+        for (int i = 0; i < 120; ++i) w.step(1.0f/120.0f);
+        std::vector<Vec3> out;
+        for (auto id : ids) out.push_back(w.getPosition(id));
+        return out;
+    };
+    const auto a = run(BroadphaseType::SweepAndPrune);
+    const auto b = run(BroadphaseType::DynamicTree);
+    for (std::size_t i = 0; i < a.size(); ++i) assert(a[i].x == b[i].x && a[i].y == b[i].y && a[i].z == b[i].z);
+    return 0;
+}
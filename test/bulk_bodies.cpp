@@ -0,0 +1,63 @@
+#include "ape/ape.h"
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+int main(){
+    using namespace ape;
+    std::vector<RigidBodyDesc> descs(1000);
+    for (std::size_t i = 0; i < descs.size(); ++i) {
+        descs[i].position = {static_cast<float>(i % 10), static_cast<float>(i / 10), 0};
+        descs[i].velocity = {0, 0, static_cast<float>(i)};
+        descs[i].shape_type = (i % 3 == 0) ? ShapeType::Box : ShapeType::Sphere;
+    }
+
+    // Bulk create/destroy takes the same slots and handles as one-at-a-time calls
+    World single;
+    World bulk;
+    bulk.reserve(2000);
+    std::vector<std::uint32_t> ids_s, ids_b(descs.size());
+    for (const auto& d : descs) ids_s.push_back(single.createRigidBody(d));
+    [[maybe_unused]] const std::size_t created = bulk.createRigidBodies(descs, ids_b);
+    assert(created == descs.size());
+    assert(ids_s == ids_b);
+
+    std::vector<std::uint32_t> doomed;
+    for (std::size_t i = 0; i < ids_b.size(); i += 7) doomed.push_back(ids_b[i]);
+    for (std::uint32_t id : doomed) single.destroyRigidBody(id);
+    bulk.destroyRigidBodies(doomed);
+    assert(bulk.bodyCount() == single.bodyCount());
+    for ([[maybe_unused]] std::uint32_t id : doomed) assert(!bulk.isAlive(id));
+
+    // Refill: free slots first, then new ones
+    std::vector<std::uint32_t> more_s, more_b(300);
+    for (std::size_t i = 0; i < 300; ++i) more_s.push_back(single.createRigidBody(descs[i]));
+    [[maybe_unused]] const std::size_t refilled = bulk.createRigidBodies(std::span(descs).first(300), more_b);
+    assert(refilled == 300);
+    assert(more_s == more_b);
+
+    single.step(1.0f/60.0f);
+    bulk.step(1.0f/60.0f);
+    for (std::size_t i = 0; i < ids_b.size(); ++i) {
+        [[maybe_unused]] const Vec3 ps = single.getPosition(ids_s[i]);
+        [[maybe_unused]] const Vec3 pb = bulk.getPosition(ids_b[i]);
+        assert(ps.x == pb.x && ps.y == pb.y && ps.z == pb.z);
+    }
+
+    // Output span shorter than the descs; index space exhaustion
+    {
+        WorldDesc desc;
+        desc.index_bits = 8; // 255 bodies
+        World w(desc);
+        std::vector<std::uint32_t> out(10);
+        [[maybe_unused]] const std::size_t first = w.createRigidBodies(descs, out);
+        assert(first == 10);
+        assert(w.bodyCount() == 10);
+        std::vector<std::uint32_t> rest(descs.size());
+        [[maybe_unused]] const std::size_t second = w.createRigidBodies(descs, rest);
+        assert(second == 245);
+        assert(rest[244] != UINT32_MAX && rest[245] == UINT32_MAX && rest.back() == UINT32_MAX);
+        assert(w.bodyCount() == 255);
+    }
+    return 0;
+}
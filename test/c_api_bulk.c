@@ -0,0 +1,22 @@
+#include "ape/ape_c.h"
+#include <assert.h>
+#include <stddef.h>
+
+int main(){
+    ape_world* w = ape_world_create_ex(NULL);
+    ape_rigidbody_desc d; d.position=(ape_vec3){0,0,0}; d.velocity=(ape_vec3){0,0,0}; d.mass=1.0f; d.radius=0.5f;
+    // Bulk create/destroy
+    ape_rigidbody_desc descs[64];
+    uint32_t ids[64];
+    for (int i = 0; i < 64; ++i) { descs[i] = d; descs[i].position.x = (float)i * 2.0f; }
+    ape_world_reserve(w, 128);
+    const size_t created = ape_world_create_rigidbodies(w, descs, 64, ids);
+    (void)created;
+    assert(created == 64);
+    assert(ape_world_body_count(w) == 64);
+    ape_world_destroy_rigidbodies(w, ids, 32);
+    assert(ape_world_body_count(w) == 32);
+    assert(ape_world_is_alive(w, ids[0]) == 0u && ape_world_is_alive(w, ids[63]) == 1u);
+    ape_world_destroy(w);
+    return 0;
+}
@@ -0,0 +1,27 @@
+#include "ape/ape_c.h"
+#include <assert.h>
+#include <stddef.h>
+
+int main(){
+    // Default layout: 16 index bits
+    ape_world* w = ape_world_create_ex(NULL);
+    assert(ape_world_max_bodies(w) == 65535);
+    ape_world_destroy(w);
+
+    // Wider handle layout holds more bodies than the default allows
+    ape_world_desc desc; desc.index_bits = 20;
+    w = ape_world_create_ex(&desc);
+    assert(ape_world_max_bodies(w) == (1u << 20) - 1u);
+    ape_rigidbody_desc d; d.velocity=(ape_vec3){0,0,0}; d.mass=1.0f; d.radius=0.5f;
+    uint32_t id = UINT32_MAX;
+    for (int i = 0; i < 70000; ++i) {
+        d.position = (ape_vec3){(float)(i % 300) * 2.0f, 0, (float)(i / 300) * 2.0f};
+        id = ape_world_create_rigidbody(w, d);
+        assert(id != UINT32_MAX);
+    }
+    assert(ape_world_body_count(w) == 70000);
+    (void)id;
+    assert(ape_world_is_alive(w, id) == 1u);
+    ape_world_destroy(w);
+    return 0;
+}
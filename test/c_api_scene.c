@@ -0,0 +1,36 @@
+#include "ape/ape_c.h"
+#include <assert.h>
+#include <stddef.h>
+#include <stdio.h>
+
+int main(){
+    ape_world* w = ape_world_create();
+    ape_rigidbody_desc d; d.position=(ape_vec3){0,5,0}; d.velocity=(ape_vec3){0,0,0}; d.mass=1.0f; d.radius=0.5f;
+    uint32_t id = ape_world_create_rigidbody(w, d);
+    for (int i=0;i<60;i++) ape_world_step(w, 1.0f/60.0f);
+    ape_vec3 p = ape_world_get_position(w, id);
+    (void)p;
+
+    // Scene round trip through a file
+    const char* scene = "ape_c_scene.apescene";
+    const int saved = ape_world_save_scene(w, scene);
+    (void)saved;
+    assert(saved == 1);
+    ape_world* copy = ape_world_create_from_scene(scene);
+    assert(copy && ape_world_body_count(copy) == 1);
+    ape_vec3 q = ape_world_get_position(copy, id);
+    (void)q;
+    assert(q.x == p.x && q.y == p.y && q.z == p.z);
+
+    // A missing file fails and leaves the world alone
+    const int loaded = ape_world_load_scene(copy, "missing.apescene");
+    (void)loaded;
+    assert(loaded == 0 && ape_world_body_count(copy) == 1);
+    ape_world* missing = ape_world_create_from_scene("missing.apescene");
+    (void)missing;
+    assert(missing == NULL);
+    ape_world_destroy(copy);
+    remove(scene);
+    ape_world_destroy(w);
+    return 0;
+}
@@ -0,0 +1,23 @@
+#include "ape/ape_c.h"
+#include <assert.h>
+#include <stddef.h>
+
+int main(){
+    ape_world* w = ape_world_create();
+    ape_rigidbody_desc d; d.position=(ape_vec3){0,0,0}; d.velocity=(ape_vec3){0,0,0}; d.radius=0.5f;
+    // Zero mass: static, gravity does not move it
+    d.mass = 0.0f;
+    uint32_t floor_id = ape_world_create_rigidbody(w, d);
+    assert(ape_world_is_static(w, floor_id) == 1u);
+    ape_world_step(w, 1.0f/60.0f);
+    assert(ape_world_get_position(w, floor_id).y == 0.0f);
+    d.mass = 1.0f;
+    d.position = (ape_vec3){5,0,0};
+    uint32_t ball = ape_world_create_rigidbody(w, d);
+    (void)ball;
+    assert(ape_world_is_static(w, ball) == 0u);
+    ape_world_destroy_rigidbody(w, floor_id);
+    assert(ape_world_is_static(w, floor_id) == 0u && ape_world_is_static(NULL, floor_id) == 0u);
+    ape_world_destroy(w);
+    return 0;
+}
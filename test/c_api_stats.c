@@ -0,0 +1,22 @@
+#include "ape/ape_c.h"
+#include <assert.h>
+#include <stddef.h>
+
+int main(){
+    ape_world* w = ape_world_create();
+    ape_rigidbody_desc d; d.position=(ape_vec3){0,5,0}; d.velocity=(ape_vec3){0,0,0}; d.mass=1.0f; d.radius=0.5f;
+    ape_world_create_rigidbody(w, d);
+    ape_world_step(w, 1.0f/60.0f);
+
+    // Filled when stats are compiled in, zeroed otherwise
+    ape_step_stats st;
+    if (ape_world_get_step_stats(w, &st)) {
+        assert(st.bodies == 1 && st.awake_bodies == 1 && st.contacts == 0);
+        assert(st.total_ms >= st.integrate_ms);
+    } else {
+        assert(st.bodies == 0 && st.total_ms == 0.0);
+    }
+    assert(ape_world_get_step_stats(NULL, &st) == 0);
+    ape_world_destroy(w);
+    return 0;
+}
@@ -0,0 +1,82 @@
+#include "ape/ape_c.h"
+#include <assert.h>
+#include <string.h>
+
+int main(){
+    ape_world* w = ape_world_create();
+    ape_vec3 g = {0, 0, 0};
+    ape_world_set_gravity(w, g);
+    ape_rigidbody_desc d; d.velocity=(ape_vec3){1,0,0}; d.mass=1.0f; d.radius=0.5f;
+    uint32_t ids[16];
+    for (int i = 0; i < 16; ++i) {
+        d.position = (ape_vec3){0, 0, (float)i * 2.0f};
+        ids[i] = ape_world_create_rigidbody(w, d);
+    }
+    ape_world_destroy_rigidbody(w, ids[3]);
+    ape_world_step(w, 0.5f);
+
+    size_t n = 0, n_alive = 0, n_live = 0;
+    const ape_vec3* pos = ape_world_get_positions_ptr(w, &n);
+    const uint8_t* alive = ape_world_get_alive_ptr(w, &n_alive);
+    (void)alive;
+    const uint32_t* live = ape_world_get_live_slots_ptr(w, &n_live);
+    (void)live;
+    assert(pos && alive && live);
+    assert(n == 16 && n_alive == 16 && n_live == 15);
+    assert(ape_world_get_velocities_ptr(w, NULL) != NULL && ape_world_get_awake_ptr(w, NULL) != NULL);
+
+    // One memcpy reads back every slot
+    ape_vec3 frame[16];
+    memcpy(frame, pos, n * sizeof(ape_vec3));
+    for (int i = 0; i < 16; ++i) {
+        uint32_t slot = ape_world_slot_of(w, ids[i]);
+        (void)slot;
+        if (i == 3) { assert(slot == UINT32_MAX && alive[3] == 0); continue; }
+        assert(ape_world_handle_at(w, slot) == ids[i]);
+        ape_vec3 p; ape_world_get_position_out(w, ids[i], &p);
+        assert(frame[slot].x == p.x && frame[slot].z == p.z && p.x == 0.5f);
+    }
+    assert(ape_world_get_positions_ptr(NULL, &n) == NULL && n == 0);
+
+    // Batch entry points used by the NumPy bindings
+    uint32_t slots[16];
+    ape_world_slots_of(w, ids, 16, slots);
+    assert(slots[3] == UINT32_MAX && slots[4] == 4u);
+    ape_vec3 targets[2] = {{10, 0, 0}, {20, 0, 0}};
+    ape_world_set_positions(w, ids, targets, 2);
+    ape_vec3 zero[16];
+    memset(zero, 0, sizeof(zero));
+    ape_world_set_velocities(w, ids, zero, 16);
+    ape_world_step_n(w, 0.1f, 5);
+    pos = ape_world_get_positions_ptr(w, NULL);
+    assert(pos[slots[0]].x == 10.0f && pos[slots[1]].x == 20.0f && pos[slots[4]].x == 0.5f);
+
+    ape_rigidbody_desc_ex ex[2];
+    memset(ex, 0, sizeof(ex));
+    ex[0].shape = 1; ex[0].mass = 1.0f; ex[0].half_extents = (ape_vec3){1, 2, 3}; ex[0].position = (ape_vec3){50, 0, 0};
+    ex[1].shape = 0; ex[1].mass = 1.0f; ex[1].radius = 0.25f; ex[1].position = (ape_vec3){60, 0, 0};
+    uint32_t ex_ids[2];
+    const size_t ex_created = ape_world_create_rigidbodies_ex(w, ex, 2, ex_ids);
+    (void)ex_created;
+    assert(ex_created == 2);
+    assert(ape_world_is_alive(w, ex_ids[0]) && ape_world_is_alive(w, ex_ids[1]));
+
+    // Collision layers: two overlapping spheres that ignore their own category
+    // stay put; a zeroed filter (the default) collides with everything
+    memset(ex, 0, sizeof(ex));
+    for (int i = 0; i < 2; ++i) {
+        ex[i].mass = 1.0f; ex[i].radius = 0.5f; ex[i].position = (ape_vec3){100.0f + 0.4f * (float)i, 0, 0};
+        ex[i].collision_category = 2u; ex[i].collision_mask = ~2u;
+    }
+    ape_world_create_rigidbodies_ex(w, ex, 2, ex_ids);
+    ape_world_step(w, 1.0f / 60.0f);
+    ape_vec3 q0 = ape_world_get_position(w, ex_ids[0]);
+    (void)q0;
+    assert(q0.x == 100.0f);
+    ape_world_set_collision_filter(w, ex_ids[0], 1u, 0xFFFFFFFFu);
+    ape_world_step(w, 1.0f / 60.0f);
+    q0 = ape_world_get_position(w, ex_ids[0]);
+    assert(q0.x < 100.0f);
+    ape_world_destroy(w);
+    return 0;
+}
@@ -0,0 +1,161 @@
+#include "ape/ape.h"
+#include "ape/broadphase.h"
+#include "ape/dynamic_tree.h"
+#include "ape/job.h"
+#include "broadphase_test_util.h"
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace ape;
+
+int main(){
+    const float dt = 1.0f / 60.0f;
+
+    // Every backend drops filtered pairs and keeps the rest in (a, b) order
+    {
+        TestRandom rnd{99u};
+        std::vector<AABB> boxes;
+        std::vector<CollisionFilter> filters;
+        for (int i = 0; i < 2000; ++i) {
+            const float x = rnd() * 60.0f, y = rnd() * 4.0f, z = rnd() * 20.0f, r = 0.3f + rnd() * 0.5f;
+            boxes.push_back(AABB{x - r, y - r, z - r, x + r, y + r, z + r});
+            // Layers 1, 2 and 4; layer 2 ignores itself, layer 4 only meets layer 1
+            const std::uint32_t layer = 1u << (i % 3);
+            filters.push_back(CollisionFilter{layer, layer == 2u ? ~2u : layer == 4u ? 1u : 0xFFFFFFFFu});
+        }
+        boxes.push_back(AABB{0, 0, 0, 60, 1, 20}); // one box over everything
+        filters.push_back(CollisionFilter{});
+
+        std::vector<Pair> all, expected;
+        broadphase_naive(boxes.data(), boxes.size(), all);
+        std::sort(all.begin(), all.end(), pair_less);
+        for (const Pair& p : all) if (filters_collide(filters[p.a], filters[p.b])) expected.push_back(p);
+        assert(expected.size() < all.size() * 2 / 3 && !expected.empty()); // about 5/9 kept
+
+        std::vector<Pair> pairs;
+        SweepAndPrune sap;
+        sap.update(boxes.data(), boxes.size(), pairs, filters.data());
+        assert(same_pairs(pairs, expected));
+        sap.update(boxes.data(), boxes.size(), pairs); // no filters: everything again
+        assert(same_pairs(pairs, all));
+        DynamicTreeBroadphase tree;
+        tree.update(boxes.data(), boxes.size(), pairs, filters.data());
+        assert(same_pairs(pairs, expected));
+        SpatialHashGrid grid;
+        grid.update(boxes.data(), boxes.size(), pairs, filters.data());
+        assert(same_pairs(pairs, expected));
+        JobSystem jobs(4);
+        RegionBroadphase regions(4, 2);
+        regions.update(boxes.data(), boxes.size(), pairs, &jobs, filters.data());
+        assert(same_pairs(pairs, expected));
+    }
+
+    // Debris does not collide with debris, only with the floor
+    {
+        World w;
+        RigidBodyDesc floor{};
+        floor.mass = 0.0f;
+        floor.shape_type = ShapeType::Box;
+        floor.box_half_extents = {20.0f, 0.5f, 20.0f};
+        floor.position = {0, -0.5f, 0};
+        w.createRigidBody(floor);
+        RigidBodyDesc d{};
+        d.collision_category = 2u;
+        d.collision_mask = ~2u;
+        std::vector<std::uint32_t> debris;
+        for (int i = 0; i < 50; ++i) {
+            d.position = {0.3f * static_cast<float>(i % 5), 1.0f + 0.3f * static_cast<float>(i / 5), 0};
+            debris.push_back(w.createRigidBody(d));
+        }
+        w.step(dt);
+        assert(w.debug_broadphasePairCount() == 0); // heavily overlapping, yet no pairs
+        for (int i = 0; i < 240; ++i) w.step(dt);
+        for ([[maybe_unused]] auto id : debris) assert(std::fabs(w.getPosition(id).y - 0.5f) < 0.02f);
+    }
+
+    // Projectiles pass through each other until their filter changes
+    {
+        World w;
+        w.setGravity({0, 0, 0});
+        RigidBodyDesc p{};
+        p.collision_category = 4u;
+        p.collision_mask = ~4u;
+        p.position = {-2, 0, 0};
+        p.velocity = {6, 0, 0};
+        const auto a = w.createRigidBody(p);
+        p.position = {2, 0, 0};
+        p.velocity = {-6, 0, 0};
+        const auto b = w.createRigidBody(p);
+        for (int i = 0; i < 40; ++i) w.step(dt);
+        assert(w.getPosition(a).x > 1.9f && w.getPosition(b).x < -1.9f);
+
+        w.setVelocity(a, {-6, 0, 0});
+        w.setVelocity(b, {6, 0, 0});
+        w.setCollisionFilter(a, 4u, 0xFFFFFFFFu);
+        w.setCollisionFilter(b, 1u, 0xFFFFFFFFu);
+        for (int i = 0; i < 40; ++i) w.step(dt);
+        assert(w.getPosition(a).x > w.getPosition(b).x); // bounced off each other
+        w.setCollisionFilter(0xFFFFFFFFu, 0, 0); // invalid handle: ignored
+    }
+
+    // Masks against a static floor and between stacked bodies; filters survive
+    // a snapshot, and results match across backends and threads
+    {
+        auto run = [dt](BroadphaseType type, unsigned threads, bool restore) {
+            World w;
+            w.setBroadphase(type);
+            w.setThreadCount(threads);
+            RigidBodyDesc floor{};
+            floor.mass = 0.0f;
+            floor.shape_type = ShapeType::Box;
+            floor.box_half_extents = {10.0f, 0.5f, 10.0f};
+            floor.position = {5, -0.5f, 5};
+            floor.collision_category = 8u;
+            w.createRigidBody(floor);
+            // Two layers of 7x7 spheres (plus two on top); every 5th ignores the
+            // floor, every 3rd of the rest ignores category 2
+            RigidBodyDesc d{};
+            std::vector<std::uint32_t> ids;
+            for (int i = 0; i < 100; ++i) {
+                d.position = {1.5f * static_cast<float>(i % 7), 0.55f + 1.05f * static_cast<float>(i / 49),
+                              1.5f * static_cast<float>((i / 7) % 7)};
+                d.collision_category = (i % 2) ? 2u : 1u;
+                d.collision_mask = (i % 5 == 0) ? ~8u : (i % 3 == 0) ? ~2u : 0xFFFFFFFFu;
+                ids.push_back(w.createRigidBody(d));
+            }
+            WorldSnapshot snap;
+            for (int i = 0; i < 60; ++i) {
+                w.step(dt);
+                if (i == 20) w.saveSnapshot(snap);
+            }
+            if (restore) {
+                for (auto id : ids) w.setCollisionFilter(id, 1u, 1u);
+                [[maybe_unused]] const bool ok = w.restoreSnapshot(snap);
+                assert(ok);
+                for (int i = 21; i < 60; ++i) w.step(dt);
+            }
+            std::vector<Vec3> out;
+            for (auto id : ids) out.push_back(w.getPosition(id));
+            return out;
+        };
+        const auto ref = run(BroadphaseType::SweepAndPrune, 1, false);
+        assert(ref[0].y < -1.0f && ref[5].y < -1.0f); // fell through the floor
+        assert(std::fabs(ref[2].y - 0.5f) < 0.02f);
+        assert(std::fabs(ref[51].y - 1.5f) < 0.02f); // rests on sphere 2
+        assert(std::fabs(ref[61].y - 0.5f) < 0.02f); // passed through sphere 12 (mask ~2)
+        [[maybe_unused]] auto same = [&ref](const std::vector<Vec3>& v) {
+            for (std::size_t i = 0; i < ref.size(); ++i)
+                if (v[i].x != ref[i].x || v[i].y != ref[i].y || v[i].z != ref[i].z) return false;
+            return true;
+        };
+        for (int bp = 0; bp < 4; ++bp) {
+            assert(same(run(static_cast<BroadphaseType>(bp), 1, false)));
+            assert(same(run(static_cast<BroadphaseType>(bp), 4, false)));
+        }
+        assert(same(run(BroadphaseType::SweepAndPrune, 1, true)));
+    }
+    return 0;
+}
@@ -0,0 +1,51 @@
+#include "ape/contact_cache.h"
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+
+int main(){
+    ape::ContactCache cache;
+    assert(cache.find(0, 1) == nullptr);
+
+    // One frame of contacts: every pair is found with its impulses
+    cache.reset(1000);
+    for (std::uint32_t i = 0; i < 1000; ++i) cache.insert(i, i + 1, static_cast<float>(i), ape::Vec3{1, 2, static_cast<float>(i)});
+    assert(cache.size() == 1000);
+    for (std::uint32_t i = 0; i < 1000; ++i) {
+        [[maybe_unused]] const auto* e = cache.find(i, i + 1);
+        assert(e && e->normal_impulse == static_cast<float>(i) && e->tangent_impulse.z == static_cast<float>(i));
+    }
+    assert(cache.find(1, 0) == nullptr); // ordered key
+    assert(cache.find(5, 7) == nullptr);
+
+    // Overwrite keeps a single entry
+    cache.insert(3, 4, 9.0f, ape::Vec3{0, 0, 0});
+    assert(cache.size() == 1000 && cache.find(3, 4)->normal_impulse == 9.0f);
+
+    // New frame drops old entries without reallocating
+    [[maybe_unused]] const std::size_t cap = cache.capacity();
+    cache.reset(800);
+    assert(cache.size() == 0 && cache.find(3, 4) == nullptr);
+    for (std::uint32_t i = 0; i < 800; ++i) cache.insert(2 * i, 2 * i + 7, 1.0f, ape::Vec3{0, 0, 0});
+    assert(cache.capacity() == cap);
+    assert(cache.find(0, 7) && !cache.find(0, 1));
+
+    // Inserting more than announced grows and keeps live entries
+    cache.reset(4);
+    for (std::uint32_t i = 0; i < 5000; ++i) cache.insert(i, 70000 + i, static_cast<float>(i), ape::Vec3{0, 0, 0});
+    assert(cache.size() == 5000);
+    for (std::uint32_t i = 0; i < 5000; ++i) assert(cache.find(i, 70000 + i)->normal_impulse == static_cast<float>(i));
+
+    // restore() reproduces a table and rejects one slots() could not have produced
+    const auto table = cache.slots();
+    const auto* raw = reinterpret_cast<const std::byte*>(table.data());
+    ape::ContactCache copy;
+    [[maybe_unused]] const bool same = copy.restore(raw, table.size(), cache.stamp(), cache.size());
+    assert(same && copy.size() == 5000 && copy.find(7, 70007)->normal_impulse == 7.0f);
+    [[maybe_unused]] const bool odd_slots = copy.restore(raw, table.size() - 1, cache.stamp(), 10);
+    [[maybe_unused]] const bool overfull = copy.restore(raw, 16, cache.stamp(), 9);
+    [[maybe_unused]] const bool wrong_size = copy.restore(raw, table.size(), cache.stamp(), 4999);
+    assert(!odd_slots && !overfull && !wrong_size);
+    assert(copy.size() == 5000 && copy.capacity() == table.size()); // unchanged
+    return 0;
+}
@@ -0,0 +1,59 @@
+#include "ape/ape.h"
+#include <cassert>
+#include <cmath>
+
+using namespace ape;
+
+// Head-on hit of two spheres in zero gravity; returns the final velocities
+static void head_on(float friction, Vec3& va, Vec3& vb) {
+    World w;
+    w.setGravity({0, 0, 0});
+    RigidBodyDesc d{};
+    d.friction = friction;
+    d.restitution = 0.5f;
+    d.position = {0, 0, 0};
+    d.velocity = {1, 0, 0};
+    const auto a = w.createRigidBody(d);
+    d.position = {1.2f, 0, 0};
+    d.velocity = {-1, 0, 0};
+    const auto b = w.createRigidBody(d);
+    for (int i = 0; i < 60; ++i) w.step(1.0f/60.0f);
+    va = w.getVelocity(a);
+    vb = w.getVelocity(b);
+}
+
+int main(){
+    // No tangential motion, so friction must not act: the friction row uses the
+    // relative velocity after this iteration's normal impulse, whose normal
+    // part is removed exactly
+    {
+        Vec3 fa, fb, sa, sb;
+        head_on(0.8f, fa, fb);
+        head_on(0.0f, sa, sb);
+        assert(fa.x < 0.5f && fb.x > -0.5f); // they did hit
+        assert(fa.x == sa.x && fb.x == sb.x && fa.y == 0.0f && fa.z == 0.0f);
+    }
+
+    // Glancing hit: friction removes the sliding velocity that the frictionless
+    // hit leaves (no rotation, so the pair ends up moving together)
+    {
+        [[maybe_unused]] float slide[2];
+        for (int k = 0; k < 2; ++k) {
+            World w;
+            w.setGravity({0, 0, 0});
+            RigidBodyDesc d{};
+            d.friction = k == 0 ? 0.5f : 0.0f;
+            d.velocity = {1, 0, 0};
+            const auto a = w.createRigidBody(d);
+            d.position = {1.05f, 0.5f, 0};
+            d.velocity = {0, 0, 0};
+            const auto b = w.createRigidBody(d);
+            for (int i = 0; i < 60; ++i) w.step(1.0f/60.0f);
+            const Vec3 va = w.getVelocity(a), vb = w.getVelocity(b);
+            assert(std::fabs(va.x + vb.x - 1.0f) < 1e-4f); // momentum kept
+            slide[k] = std::fabs(vb.y - va.y);
+        }
+        assert(slide[0] < 0.05f && slide[1] > 0.2f);
+    }
+    return 0;
+}
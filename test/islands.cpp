@@ -0,0 +1,59 @@
+#include "ape/ape.h"
+#include "ape/island.h"
+#include <cassert>
+#include <vector>
+
+int main(){
+    using namespace ape;
+    // Builder: 0-1-2 chain, 3-4 pair, 5 infinite mass touching 2 and 3, 6 dead, 7 alone
+    {
+        const std::uint8_t alive[8] = {1,1,1,1,1,1,0,1};
+        const float mass[8] = {1,1,1,1,1,0,1,1};
+        std::vector<Contact> contacts = {
+            {3,4, 0,1,0, 0.1f, 0.5f, 0.0f},
+            {1,2, 0,1,0, 0.1f, 0.5f, 0.0f},
+            {2,5, 0,1,0, 0.1f, 0.5f, 0.0f},
+            {0,1, 0,1,0, 0.1f, 0.5f, 0.0f},
+            {3,5, 0,1,0, 0.1f, 0.5f, 0.0f},
+        };
+        IslandBuilder ib;
+        ib.build(8, alive, mass, contacts.data(), contacts.size());
+        // {0,1,2}, {3,4}, {5}, {7}: the infinite-mass body does not merge islands
+        assert(ib.islandCount() == 4);
+        assert(ib.bodies(0).size() == 3 && ib.bodies(0)[0] == 0 && ib.bodies(0)[2] == 2);
+        assert(ib.bodies(1).size() == 2 && ib.bodies(1)[0] == 3);
+        assert(ib.bodies(2).size() == 1 && ib.bodies(2)[0] == 5);
+        assert(ib.bodies(3).size() == 1 && ib.bodies(3)[0] == 7);
+        assert(ib.islandOfBody(6) == IslandBuilder::npos);
+        // Contacts go to the island of their finite-mass body, in ascending order
+        assert(ib.contacts(0).size() == 3);
+        assert(ib.contacts(0)[0] == 1 && ib.contacts(0)[1] == 2 && ib.contacts(0)[2] == 3);
+        assert(ib.contacts(1).size() == 2 && ib.contacts(1)[0] == 0 && ib.contacts(1)[1] == 4);
+        assert(ib.contacts(2).empty());
+        assert(ib.islandOfContact(2) == 0 && ib.islandOfContact(4) == 1);
+    }
+
+    // World: islands wake only when touched by something awake
+    World w;
+    w.setGravity({0, 0, 0});
+    RigidBodyDesc d{};
+    d.sphere_radius = 0.5f;
+    d.friction = 0.0f; // the hit below is head-on: only the normal impulse matters
+    d.velocity = {0.005f, 0, 0}; // below sleep threshold
+    d.position = {0, 0, 0};
+    auto a = w.createRigidBody(d);
+    d.position = {10, 0, 0};
+    [[maybe_unused]] auto b = w.createRigidBody(d);
+    for (int i = 0; i < 120; ++i) w.step(1.0f/120.0f);
+    assert(w.getVelocity(a).x == 0.0f && w.getVelocity(b).x == 0.0f); // both asleep
+
+    [[maybe_unused]] const Vec3 pa = w.getPosition(a);
+    d.position = {8.5f, 0, 0};
+    d.velocity = {2.0f, 0, 0};
+    w.createRigidBody(d);
+    for (int i = 0; i < 60; ++i) w.step(1.0f/120.0f);
+    assert(w.getVelocity(b).x > 0.1f);  // hit and woken
+    [[maybe_unused]] const Vec3 pa2 = w.getPosition(a);
+    assert(pa2.x == pa.x && w.getVelocity(a).x == 0.0f); // other island untouched
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include "ape/job.h"
+#include <cassert>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+int main(){
+    ape::JobSystem js(4);
+    assert(js.worker_count() == 4);
+
+    // Counter-based completion: wait only for our own jobs; more jobs than
+    // the deque holds must still all run (overflow executes inline).
+    std::atomic<int> ran{0};
+    ape::JobCounter counter;
+    for (int i = 0; i < 2000; ++i) js.enqueue([&ran]{ ran.fetch_add(1); }, &counter);
+    js.wait(counter);
+    assert(counter.done());
+    assert(ran.load() == 2000);
+
+    // parallel_for covers every index exactly once
+    std::vector<std::atomic<int>> hits(10007);
+    js.parallel_for(hits.size(), 64, [&](std::size_t b, std::size_t e){
+        for (std::size_t i = b; i < e; ++i) hits[i].fetch_add(1);
+    });
+    for ([[maybe_unused]] auto& h : hits) assert(h.load() == 1);
+
+    // Nested parallel_for from inside jobs must not deadlock
+    std::atomic<int> nested{0};
+    js.parallel_for(8, 1, [&](std::size_t, std::size_t){
+        js.parallel_for(100, 10, [&](std::size_t b, std::size_t e){ nested.fetch_add(static_cast<int>(e - b)); });
+    });
+    assert(nested.load() == 800);
+
+    // parallel_reduce combines partials in chunk order: float sums are
+    // reproducible run to run regardless of scheduling
+    std::vector<float> values(100000);
+    for (std::size_t i = 0; i < values.size(); ++i) values[i] = 1.0f / static_cast<float>(i + 1);
+    auto sum = [&]{
+        return js.parallel_reduce(values.size(), 1000, 0.0f,
+            [&](std::size_t b, std::size_t e){ float s = 0.0f; for (std::size_t i = b; i < e; ++i) s += values[i]; return s; },
+            [](float a, float b){ return a + b; });
+    };
+    [[maybe_unused]] const float s0 = sum();
+    for (int i = 0; i < 10; ++i) assert(sum() == s0);
+    [[maybe_unused]] const std::uint64_t count = js.parallel_reduce(values.size(), 7, std::uint64_t{0},
+        [](std::size_t b, std::size_t e){ return static_cast<std::uint64_t>(e - b); },
+        [](std::uint64_t a, std::uint64_t b){ return a + b; });
+    assert(count == values.size());
+
+    // wait_idle drains everything outstanding
+    for (int i = 0; i < 100; ++i) js.enqueue([&ran]{ ran.fetch_add(1); });
+    js.wait_idle();
+    assert(ran.load() == 2100);
+
+    // Destroying the system runs jobs still queued instead of dropping them
+    std::atomic<int> late{0};
+    {
+        ape::JobSystem short_lived(2);
+        for (int i = 0; i < 500; ++i) short_lived.enqueue([&late]{ late.fetch_add(1); });
+    }
+    assert(late.load() == 500);
+    return 0;
+}
@@ -0,0 +1,74 @@
+#include "ape/ape.h"
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+int main(){
+    using namespace ape;
+
+    // Default layout: 16 index bits, creation fails once the index space is full
+    {
+        World w;
+        assert(w.maxBodies() == 65535);
+        RigidBodyDesc d{};
+        for (std::size_t i = 0; i < w.maxBodies(); ++i) {
+            d.position = {static_cast<float>(i % 256) * 2.0f, static_cast<float>(i / 256) * 2.0f, 0};
+            [[maybe_unused]] const std::uint32_t id = w.createRigidBody(d);
+            assert(id != UINT32_MAX);
+        }
+        [[maybe_unused]] const std::uint32_t overflow = w.createRigidBody(d);
+        assert(overflow == UINT32_MAX);
+        assert(w.bodyCount() == 65535);
+    }
+
+    // 20 index bits: 300k bodies step and keep distinct, valid handles
+    {
+        WorldDesc desc;
+        desc.index_bits = 20;
+        World w(desc);
+        assert(w.maxBodies() == (1u << 20) - 1u);
+        w.setGravity({0, 0, 0});
+        RigidBodyDesc d{};
+        d.velocity = {0, 1, 0};
+        std::vector<std::uint32_t> ids;
+        const int count = 300000;
+        for (int i = 0; i < count; ++i) {
+            d.position = {static_cast<float>(i % 1000) * 2.0f, 0, static_cast<float>(i / 1000) * 2.0f};
+            ids.push_back(w.createRigidBody(d));
+        }
+        assert(w.bodyCount() == static_cast<std::size_t>(count));
+        w.step(0.5f);
+        for (int i = 0; i < count; i += 997) {
+            [[maybe_unused]] const Vec3 p = w.getPosition(ids[i]);
+            assert(p.x == static_cast<float>(i % 1000) * 2.0f && p.y == 0.5f);
+        }
+        assert(w.getPosition(ids[count - 1]).z == 598.0f);
+
+        // Slots above 65,535 recycle with a new generation
+        const std::uint32_t old = ids[count - 1];
+        w.destroyRigidBody(old);
+        [[maybe_unused]] const std::uint32_t fresh = w.createRigidBody(d);
+        assert(fresh != old && (fresh & 0xFFFFFu) == (old & 0xFFFFFu));
+        assert(!w.isAlive(old) && w.isAlive(fresh));
+    }
+
+    // Generations wrap within the remaining bits: 28 index bits leave 16 generations
+    {
+        WorldDesc desc;
+        desc.index_bits = 40; // clamped to 28
+        World w(desc);
+        assert(w.maxBodies() == (1u << 28) - 1u);
+        RigidBodyDesc d{};
+        std::uint32_t first = w.createRigidBody(d);
+        std::uint32_t h = first;
+        for (int i = 0; i < 15; ++i) {
+            w.destroyRigidBody(h);
+            h = w.createRigidBody(d);
+            assert(h != first && !w.isAlive(first));
+        }
+        w.destroyRigidBody(h);
+        h = w.createRigidBody(d);
+        assert(h == first);
+    }
+    return 0;
+}
@@ -0,0 +1,92 @@
+#include "ape/narrowphase.h"
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace ape;
+
+[[maybe_unused]] static bool near(float a, float b) { return std::fabs(a - b) < 1e-5f; }
+
+static const Contact* find(const std::vector<Contact>& cs, std::uint32_t a, std::uint32_t b) {
+    for (const Contact& c : cs) if (c.a == a && c.b == b) return &c;
+    return nullptr;
+}
+
+int main(){
+    const auto S = static_cast<std::uint8_t>(ShapeType::Sphere);
+    const auto B = static_cast<std::uint8_t>(ShapeType::Box);
+
+    // Mixed bodies: pairs of every shape combination, interleaved, in a count
+    // that is not a multiple of any lane width (tail blocks)
+    std::vector<Vec3> pos;
+    std::vector<std::uint8_t> type;
+    std::vector<float> radius;
+    std::vector<Vec3> half;
+    std::vector<float> friction;
+    std::vector<float> restitution;
+    const auto add = [&](Vec3 p, std::uint8_t t, float r, Vec3 h, float f, float e) {
+        pos.push_back(p); type.push_back(t); radius.push_back(r); half.push_back(h);
+        friction.push_back(f); restitution.push_back(e);
+        return static_cast<std::uint32_t>(pos.size() - 1);
+    };
+    std::vector<Pair> pairs;
+    for (int i = 0; i < 11; ++i) {
+        const float x = 10.0f * static_cast<float>(i);
+        // sphere-sphere, overlapping along x by 0.2
+        const auto s0 = add({x, 0, 0}, S, 0.5f, {0, 0, 0}, 0.25f, 0.4f);
+        const auto s1 = add({x + 0.8f, 0, 0}, S, 0.5f, {0, 0, 0}, 1.0f, 0.1f);
+        // box (a) - sphere (b): sphere 0.3 above the top face, radius 0.5
+        const auto b0 = add({x, 5, 0}, B, 0.0f, {1, 1, 1}, 0.5f, 0.5f);
+        const auto s2 = add({x, 6.3f, 0}, S, 0.5f, {0, 0, 0}, 0.5f, 0.5f);
+        // box-box, overlapping 0.1 along z, more along x and y
+        const auto b1 = add({x, -5, 0}, B, 0.0f, {0.5f, 0.5f, 0.5f}, 0.5f, 0.0f);
+        const auto b2 = add({x + 0.2f, -5.1f, -0.9f}, B, 0.0f, {0.5f, 0.5f, 0.5f}, 0.5f, 0.0f);
+        // sphere-sphere out of reach
+        const auto s3 = add({x, 0, 5}, S, 0.5f, {0, 0, 0}, 0.5f, 0.0f);
+        pairs.push_back({s0, s1});
+        pairs.push_back({b0, s2});
+        pairs.push_back({b1, b2});
+        pairs.push_back({s0, s3});
+    }
+    // Sphere center inside a box: scalar face-selection fallback
+    const auto inner_box = add({100, 0, 0}, B, 0.0f, {1, 2, 3}, 0.5f, 0.0f);
+    const auto inner_sphere = add({100.7f, 0, 0}, S, 0.25f, {0, 0, 0}, 0.5f, 0.0f);
+    pairs.push_back({inner_sphere, inner_box});
+
+    std::vector<Contact> out;
+    generate_contacts(pos.data(), type.data(), radius.data(), half.data(), friction.data(), restitution.data(),
+                      pos.size(), pairs, out);
+    assert(out.size() == 3 * 11 + 1);
+
+    for (int i = 0; i < 11; ++i) {
+        const std::uint32_t o = static_cast<std::uint32_t>(7 * i);
+        [[maybe_unused]] const Contact* ss = find(out, o, o + 1);
+        assert(ss && near(ss->nx, 1) && near(ss->ny, 0) && near(ss->penetration, 0.2f));
+        assert(near(ss->friction, 0.5f) && near(ss->restitution, 0.1f));
+        // Sphere-box normal points from the box to the sphere
+        [[maybe_unused]] const Contact* sb = find(out, o + 2, o + 3);
+        assert(sb && near(sb->ny, 1) && near(sb->nx, 0) && near(sb->penetration, 0.2f));
+        // Box-box: least-penetration axis is z, pointing from a to b
+        [[maybe_unused]] const Contact* bb = find(out, o + 4, o + 5);
+        assert(bb && near(bb->nz, -1) && near(bb->penetration, 0.1f));
+        assert(!find(out, o, o + 6));
+    }
+    [[maybe_unused]] const Contact* in = find(out, inner_sphere, inner_box);
+    assert(in && near(in->nx, 1) && near(in->penetration, 0.25f + 0.3f));
+
+    // Sphere-only input matches the scalar sphere-sphere routine
+    std::vector<Pair> sphere_pairs;
+    for (const Pair& p : pairs) if (type[p.a] == S && type[p.b] == S) sphere_pairs.push_back(p);
+    std::vector<Contact> batched, scalar;
+    generate_contacts(pos.data(), type.data(), radius.data(), half.data(), friction.data(), restitution.data(),
+                      pos.size(), sphere_pairs, batched);
+    generate_contacts_sphere_sphere(pos.data(), radius.data(), friction.data(), restitution.data(),
+                                    pos.size(), sphere_pairs, scalar);
+    assert(batched.size() == scalar.size());
+    for (std::size_t i = 0; i < scalar.size(); ++i) {
+        assert(batched[i].a == scalar[i].a && batched[i].b == scalar[i].b);
+        assert(near(batched[i].nx, scalar[i].nx) && near(batched[i].penetration, scalar[i].penetration));
+    }
+    return 0;
+}
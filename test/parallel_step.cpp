@@ -0,0 +1,54 @@
+#include "ape/ape.h"
+#include "ape/job.h"
+#include <cassert>
+#include <vector>
+#include <cstdint>
+
+// Fill a world with a dense pile so every stage has enough work to be split.
+static std::vector<std::uint32_t> build(ape::World& w) {
+    std::vector<std::uint32_t> ids;
+    ape::RigidBodyDesc d{};
+    d.mass = 1.0f;
+    d.sphere_radius = 0.5f;
+    for (int i = 0; i < 1200; ++i) {
+        d.position = {0.45f * static_cast<float>(i % 40), 0.45f * static_cast<float>(i / 40), 0.3f * static_cast<float>(i % 7)};
+        ids.push_back(w.createRigidBody(d));
+    }
+    return ids;
+}
+
+int main(){
+    // Threaded stepping must match single-threaded stepping bit for bit
+    ape::World serial;
+    ape::World owned;
+    ape::World borrowed;
+    ape::JobSystem js(3);
+    owned.setThreadCount(4);
+    borrowed.setJobSystem(&js);
+    assert(owned.jobSystem() != nullptr);
+    assert(borrowed.jobSystem() == &js);
+
+    auto ids_s = build(serial);
+    auto ids_o = build(owned);
+    auto ids_b = build(borrowed);
+    for (int i = 0; i < 10; ++i) {
+        serial.step(1.0f/120.0f);
+        owned.step(1.0f/120.0f);
+        borrowed.step(1.0f/120.0f);
+    }
+    assert(serial.debug_broadphasePairCount() > 0);
+    assert(serial.debug_broadphasePairCount() == owned.debug_broadphasePairCount());
+    for (std::size_t i = 0; i < ids_s.size(); ++i) {
+        [[maybe_unused]] const auto ps = serial.getPosition(ids_s[i]);
+        [[maybe_unused]] const auto po = owned.getPosition(ids_o[i]);
+        [[maybe_unused]] const auto pb = borrowed.getPosition(ids_b[i]);
+        assert(ps.x == po.x && ps.y == po.y && ps.z == po.z);
+        assert(ps.x == pb.x && ps.y == pb.y && ps.z == pb.z);
+    }
+
+    // Detaching returns to single-threaded stepping
+    owned.setThreadCount(0);
+    assert(owned.jobSystem() == nullptr);
+    owned.step(1.0f/120.0f);
+    return 0;
+}
@@ -0,0 +1,51 @@
+"""Tests of the NumPy front end (bindings/python/ape_numpy.py).
+
+Run by ctest with APE_LIB pointing at the ape_c shared library.
+"""
+import numpy as np
+
+import ape_numpy as apn
+
+
+def main():
+    # Bulk create with broadcast parameters, then read through views and copies
+    with apn.World(gravity=(0, 0, 0)) as w:
+        pos = np.array([[10.0 * i, 0, 0] for i in range(8)], dtype=np.float32)
+        ids = w.create_bodies(pos, shape=np.arange(8) % 2, velocities=(1, 0, 0))
+        assert ids.dtype == np.uint32 and ids.size == 8
+        assert np.all(ids != apn.INVALID) and w.body_count == 8
+
+        view = w.positions_view()
+        assert view.shape == (8, 3) and view.dtype == np.float32
+        assert not view.flags.writeable
+        assert np.array_equal(view[w.slots(ids)], pos)
+        assert np.all(w.alive_view() == 1) and np.all(w.awake_view() == 1)
+        assert np.array_equal(w.velocities(ids), np.tile([1, 0, 0], (8, 1)).astype(np.float32))
+
+        # Several native steps in one call; far-apart bodies move freely
+        w.step(0.25, 4)
+        assert np.allclose(w.positions(ids)[:, 0], pos[:, 0] + 1.0)
+
+        # Bulk writes, broadcast and per body
+        w.set_velocities(ids, 0.0)
+        w.set_positions(ids[:2], [[0, 5, 0], [10, 5, 0]])
+        assert np.all(w.velocities(ids) == 0.0)
+        assert np.array_equal(w.positions(ids[:2])[:, 1], [5.0, 5.0])
+
+        # Dead handles: INVALID slots, zeros in gathered copies
+        w.destroy_bodies(ids[[3, 5]])
+        assert w.body_count == 6
+        slots = w.slots(ids)
+        assert slots[3] == apn.INVALID and slots[5] == apn.INVALID and slots[4] != apn.INVALID
+        assert np.all(w.positions(ids[[3, 5]]) == 0.0)
+        assert w.alive_view().sum() == 6
+
+    # A full world hands out INVALID for the bodies that did not fit
+    with apn.World(index_bits=8) as w:
+        ids = w.create_bodies(np.zeros((300, 3), dtype=np.float32))
+        assert w.body_count == 255
+        assert np.all(ids[:255] != apn.INVALID) and np.all(ids[255:] == apn.INVALID)
+
+
+if __name__ == "__main__":
+    main()
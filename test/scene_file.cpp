@@ -0,0 +1,125 @@
+#include "ape/ape.h"
+#include "ape/scene_file.h"
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+using namespace ape;
+
+[[maybe_unused]] static bool same_state(const World& a, const World& b) {
+    const BodyView va = a.bodies(), vb = b.bodies();
+    return va.positions.size() == vb.positions.size() &&
+           std::memcmp(va.positions.data(), vb.positions.data(), va.positions.size_bytes()) == 0 &&
+           std::memcmp(va.velocities.data(), vb.velocities.data(), va.velocities.size_bytes()) == 0 &&
+           std::memcmp(va.alive.data(), vb.alive.data(), va.alive.size_bytes()) == 0 &&
+           std::memcmp(va.awake.data(), vb.awake.data(), va.awake.size_bytes()) == 0;
+}
+
+static std::vector<char> read_file(const std::string& path) {
+    std::vector<char> out(static_cast<std::size_t>(std::filesystem::file_size(path)));
+    std::FILE* f = std::fopen(path.c_str(), "rb");
+    [[maybe_unused]] const std::size_t got = std::fread(out.data(), 1, out.size(), f);
+    std::fclose(f);
+    return out;
+}
+
+static void write_file(const std::string& path, const std::vector<char>& bytes) {
+    std::FILE* f = std::fopen(path.c_str(), "wb");
+    std::fwrite(bytes.data(), 1, bytes.size(), f);
+    std::fclose(f);
+}
+
+// Offset of the first alive_list entry: 64-byte scene header, 32-byte snapshot
+// header, then 15 [u64 count][data][pad8] blocks (pos .. free_list)
+static std::size_t alive_list_offset(const std::vector<char>& bytes) {
+    static constexpr std::size_t elem[] = {12, 12, 4, 1, 4, 12, 4, 4, 8, 4, 1, 1, 4, 4, 4};
+    std::size_t at = 64 + 32;
+    for (std::size_t e : elem) {
+        std::uint64_t n;
+        std::memcpy(&n, bytes.data() + at, sizeof(n));
+        at += sizeof(n) + ((static_cast<std::size_t>(n) * e + 7) & ~std::size_t{7});
+    }
+    return at + sizeof(std::uint64_t);
+}
+
+int main(){
+    const std::string path = (std::filesystem::temp_directory_path() / "ape_scene_file_test.apescene").string();
+
+    // A level authored once: bulk-created mixed bodies, some removed, settled a bit
+    World level(WorldDesc{18});
+    std::vector<RigidBodyDesc> descs(5000);
+    for (std::size_t i = 0; i < descs.size(); ++i) {
+        const float f = static_cast<float>(i);
+        descs[i].position = {1.1f * static_cast<float>(i % 50), 1.1f * static_cast<float>(i / 2500), 1.1f * static_cast<float>((i / 50) % 50)};
+        descs[i].shape_type = (i % 4 == 0) ? ShapeType::Box : ShapeType::Sphere;
+        descs[i].friction = 0.1f + 0.0001f * f;
+    }
+    std::vector<std::uint32_t> ids(descs.size());
+    level.createRigidBodies(descs, ids);
+    for (std::size_t i = 0; i < ids.size(); i += 7) level.destroyRigidBody(ids[i]);
+    for (int i = 0; i < 5; ++i) level.step(1.0f/60.0f);
+    [[maybe_unused]] const bool saved = saveScene(level, path.c_str());
+    assert(saved);
+
+    SceneInfo info;
+    [[maybe_unused]] const bool read = readSceneInfo(path.c_str(), info);
+    assert(read);
+    assert(info.version == 3 && info.index_bits == 18);
+    assert(info.body_count == level.bodyCount() && info.slot_count == 5000);
+
+    // Loading reproduces the state and the simulation that follows
+    World loaded(WorldDesc{info.index_bits});
+    [[maybe_unused]] const bool loaded_ok = loadScene(loaded, path.c_str());
+    assert(loaded_ok);
+    assert(loaded.bodyCount() == level.bodyCount() && same_state(level, loaded));
+    assert(loaded.isAlive(ids[1]) && !loaded.isAlive(ids[7]));
+    for (int i = 0; i < 10; ++i) { level.step(1.0f/60.0f); loaded.step(1.0f/60.0f); }
+    assert(same_state(level, loaded));
+
+    // Rejected: other handle layout, missing file, corrupted, truncated or foreign data
+    World other;
+    [[maybe_unused]] const bool other_layout = loadScene(other, path.c_str());
+    assert(!other_layout && other.bodyCount() == 0);
+    [[maybe_unused]] const bool missing = loadScene(loaded, "/nonexistent/dir/scene.apescene");
+    assert(!missing);
+    [[maybe_unused]] const bool missing_info = readSceneInfo("/nonexistent/dir/scene.apescene", info);
+    assert(!missing_info);
+    {
+        // A well-framed file with a body index far out of range fails and
+        // leaves the world exactly as it was
+        const std::vector<char> good = read_file(path);
+        std::vector<char> corrupt = good;
+        const std::uint32_t bad_index = 100000000;
+        std::memcpy(corrupt.data() + alive_list_offset(corrupt), &bad_index, sizeof(bad_index));
+        write_file(path, corrupt);
+        [[maybe_unused]] const bool corrupted = loadScene(loaded, path.c_str());
+        assert(!corrupted && loaded.bodyCount() == level.bodyCount() && same_state(level, loaded));
+        loaded.step(1.0f/60.0f);
+        level.step(1.0f/60.0f);
+        assert(same_state(level, loaded));
+        write_file(path, good);
+    }
+    {
+        std::FILE* f = std::fopen(path.c_str(), "r+b");
+        assert(f);
+        std::fseek(f, 0, SEEK_END);
+        const long size = std::ftell(f);
+        std::fclose(f);
+        std::filesystem::resize_file(path, static_cast<std::uintmax_t>(size - 8));
+        [[maybe_unused]] const std::size_t before = loaded.bodyCount();
+        [[maybe_unused]] const bool truncated = loadScene(loaded, path.c_str());
+        assert(!truncated && loaded.bodyCount() == before);
+        f = std::fopen(path.c_str(), "wb");
+        std::fputs("not a scene file, just some text that is longer than a header ........", f);
+        std::fclose(f);
+        [[maybe_unused]] const bool foreign = loadScene(loaded, path.c_str());
+        [[maybe_unused]] const bool foreign_info = readSceneInfo(path.c_str(), info);
+        assert(!foreign && !foreign_info);
+    }
+    std::filesystem::remove(path);
+    return 0;
+}
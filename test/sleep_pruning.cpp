@@ -0,0 +1,147 @@
+#include "ape/ape.h"
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace ape;
+
+namespace {
+
+constexpr float dt = 1.0f / 60.0f;
+
+struct Scene {
+    World w;
+    std::vector<std::uint32_t> a, b; // two rows of touching spheres
+};
+
+void build(Scene& s) {
+    RigidBodyDesc floor{};
+    floor.mass = 0.0f;
+    floor.shape_type = ShapeType::Box;
+    floor.box_half_extents = {20.0f, 0.5f, 20.0f};
+    floor.position = {0, -0.5f, 0};
+    s.w.createRigidBody(floor);
+    RigidBodyDesc d{};
+    for (int i = 0; i < 5; ++i) {
+        d.position = {0.99f * static_cast<float>(i), 0.5f, 0};
+        s.a.push_back(s.w.createRigidBody(d));
+        d.position = {0.99f * static_cast<float>(i), 0.5f, 10};
+        s.b.push_back(s.w.createRigidBody(d));
+    }
+}
+
+bool awake(const World& w, std::uint32_t id) { return w.bodies().awake[w.slotOf(id)] != 0; }
+
+[[maybe_unused]] bool all_asleep(const Scene& s) {
+    for (auto id : s.a) if (awake(s.w, id)) return false;
+    for (auto id : s.b) if (awake(s.w, id)) return false;
+    return true;
+}
+
+// Sleep, poke row a, drop a sphere next to row b, destroy a body of row a
+std::vector<Vec3> run(BroadphaseType type, unsigned threads, bool restore) {
+    Scene s;
+    s.w.setBroadphase(type);
+    s.w.setThreadCount(threads);
+    build(s);
+    for (int i = 0; i < 300; ++i) s.w.step(dt);
+    s.w.setVelocity(s.a[0], {0, 0, 0});
+    RigidBodyDesc d{};
+    d.position = {0.99f * 5.0f, 4.0f, 10};
+    const auto dropped = s.w.createRigidBody(d);
+    WorldSnapshot snap;
+    for (int i = 0; i < 90; ++i) {
+        s.w.step(dt);
+        if (i == 30) s.w.saveSnapshot(snap);
+    }
+    if (restore) {
+        s.w.setPosition(s.b[0], {5, 5, 5});
+        [[maybe_unused]] const bool ok = s.w.restoreSnapshot(snap);
+        assert(ok);
+        for (int i = 31; i < 90; ++i) s.w.step(dt);
+    }
+    s.w.destroyRigidBody(s.a[2]);
+    for (int i = 0; i < 120; ++i) s.w.step(dt);
+    std::vector<Vec3> out;
+    for (auto id : s.a) out.push_back(s.w.getPosition(id));
+    for (auto id : s.b) out.push_back(s.w.getPosition(id));
+    out.push_back(s.w.getPosition(dropped));
+    return out;
+}
+
+} // namespace
+
+int main(){
+    // Sleeping bodies form no pairs, with each other or with static bodies,
+    // and do not move
+    {
+        Scene s;
+        build(s);
+        for (int i = 0; i < 300; ++i) s.w.step(dt);
+        assert(all_asleep(s));
+        assert(s.w.debug_broadphasePairCount() == 0);
+        [[maybe_unused]] const Vec3 p = s.w.getPosition(s.a[2]);
+        assert(std::fabs(p.y - 0.5f) < 0.02f);
+        for (int i = 0; i < 60; ++i) s.w.step(dt);
+        assert(s.w.debug_broadphasePairCount() == 0);
+        [[maybe_unused]] const Vec3 q = s.w.getPosition(s.a[2]);
+        assert(p.x == q.x && p.y == q.y && p.z == q.z);
+        if (World::statsEnabled()) {
+            assert(s.w.stepStats().awake_bodies == 0 && s.w.stepStats().contacts == 0);
+            assert(s.w.stepStats().islands == 0);
+        }
+
+        // Waking one body wakes the island it fell asleep with, not the other row
+        s.w.setVelocity(s.a[4], {0, 0, 0});
+        for ([[maybe_unused]] auto id : s.a) assert(awake(s.w, id));
+        for ([[maybe_unused]] auto id : s.b) assert(!awake(s.w, id));
+        s.w.step(dt);
+        assert(s.w.debug_broadphasePairCount() > 0);
+        for (int i = 0; i < 120; ++i) s.w.step(dt);
+        assert(all_asleep(s));
+
+        // A body landing against the end of row b wakes the whole row
+        RigidBodyDesc d{};
+        d.position = {0.99f * 5.0f, 4.0f, 10};
+        [[maybe_unused]] const auto dropped = s.w.createRigidBody(d);
+        for (int i = 0; i < 30; ++i) s.w.step(dt);
+        for ([[maybe_unused]] auto id : s.b) assert(!awake(s.w, id)); // still in the air
+        bool woke = false;
+        for (int i = 0; i < 60; ++i) {
+            s.w.step(dt);
+            woke = woke || awake(s.w, s.b[0]);
+        }
+        assert(woke);
+        for (int i = 0; i < 240; ++i) s.w.step(dt);
+        assert(std::fabs(s.w.getPosition(dropped).y - 0.5f) < 0.02f);
+        for ([[maybe_unused]] auto id : s.b) assert(std::fabs(s.w.getPosition(id).y - 0.5f) < 0.02f);
+        assert(all_asleep(s) && !awake(s.w, dropped));
+
+        // Destroying a sleeping body wakes the rest of its island only
+        s.w.destroyRigidBody(s.a[2]);
+        assert(awake(s.w, s.a[0]) && awake(s.w, s.a[4]));
+        for ([[maybe_unused]] auto id : s.b) assert(!awake(s.w, id));
+        assert(!awake(s.w, dropped));
+        for (int i = 0; i < 120; ++i) s.w.step(dt);
+        assert(!awake(s.w, s.a[0]) && s.w.debug_broadphasePairCount() == 0);
+    }
+
+    // Identical results across backends, threads and a snapshot restore taken
+    // while part of the world sleeps
+    {
+        const auto ref = run(BroadphaseType::SweepAndPrune, 1, false);
+        [[maybe_unused]] auto same = [&ref](const std::vector<Vec3>& v) {
+            for (std::size_t i = 0; i < ref.size(); ++i)
+                if (v[i].x != ref[i].x || v[i].y != ref[i].y || v[i].z != ref[i].z) return false;
+            return true;
+        };
+        for (int bp = 0; bp < 4; ++bp) {
+            assert(same(run(static_cast<BroadphaseType>(bp), 1, false)));
+            assert(same(run(static_cast<BroadphaseType>(bp), 4, false)));
+        }
+        assert(same(run(BroadphaseType::SweepAndPrune, 1, true)));
+        assert(same(run(BroadphaseType::Regions, 4, true)));
+    }
+    return 0;
+}
@@ -0,0 +1,163 @@
+#include "ape/ape.h"
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+using namespace ape;
+
+// Bit-exact copy of every slot's position and velocity
+static std::vector<Vec3> state_of(const World& w) {
+    const BodyView v = w.bodies();
+    std::vector<Vec3> out(v.positions.begin(), v.positions.end());
+    out.insert(out.end(), v.velocities.begin(), v.velocities.end());
+    return out;
+}
+
+// Byte offset of block k of a snapshot (header, then [u64 count][data][pad8]
+// per array in World order, then the warm-start table)
+static std::size_t block_offset(const WorldSnapshot& s, int k) {
+    static constexpr std::size_t elem[] = {12, 12, 4, 1, 4, 12, 4, 4, 8, 4, 1, 1, 4, 4, 4, 4, 4, 4, 4, 24, 32};
+    std::size_t at = 32;
+    for (int i = 0; i < k; ++i) {
+        std::uint64_t n;
+        std::memcpy(&n, s.bytes.data() + at, sizeof(n));
+        at += sizeof(n) + ((static_cast<std::size_t>(n) * elem[i] + 7) & ~std::size_t{7});
+    }
+    return at;
+}
+enum Block { Vel = 1, SleepNext = 13, FreeList = 14, AliveList = 15, Cache = 20 };
+
+template <class T>
+static void poke(WorldSnapshot& s, std::size_t at, T value) { std::memcpy(s.bytes.data() + at, &value, sizeof(value)); }
+
+[[maybe_unused]] static bool same_bits(const std::vector<Vec3>& a, const std::vector<Vec3>& b) {
+    return a.size() == b.size() && std::memcmp(a.data(), b.data(), a.size() * sizeof(Vec3)) == 0;
+}
+
+int main(){
+    // A colliding cluster (contacts, warm-start cache, islands falling asleep),
+    // holes in the slot range and a mix of shapes
+    World w;
+    w.setGravity({0, -2, 0});
+    std::vector<std::uint32_t> ids;
+    RigidBodyDesc d{};
+    for (int i = 0; i < 400; ++i) {
+        d.shape_type = (i % 3 == 0) ? ShapeType::Box : ShapeType::Sphere;
+        d.position = {0.95f * static_cast<float>(i % 10), 0.95f * static_cast<float>(i / 100), 0.95f * static_cast<float>((i / 10) % 10)};
+        d.velocity = {0.1f * static_cast<float>(i % 7) - 0.3f, 0, 0.1f * static_cast<float>(i % 5) - 0.2f};
+        ids.push_back(w.createRigidBody(d));
+    }
+    for (int i = 0; i < 400; i += 9) w.destroyRigidBody(ids[i]);
+    for (int i = 0; i < 30; ++i) w.step(1.0f/60.0f);
+
+    // Save, run ahead, rewind, re-simulate: identical to the bit
+    WorldSnapshot snap;
+    w.saveSnapshot(snap);
+    assert(snap.bytes.size() == w.snapshotSize());
+    [[maybe_unused]] const std::size_t bodies = w.bodyCount();
+    std::vector<std::vector<Vec3>> ahead;
+    for (int i = 0; i < 20; ++i) { w.step(1.0f/60.0f); ahead.push_back(state_of(w)); }
+    [[maybe_unused]] const std::uint32_t spawned = w.createRigidBody(d); // reuses a freed slot
+    w.destroyRigidBody(ids[1]);
+    [[maybe_unused]] const bool restored = w.restoreSnapshot(snap);
+    assert(restored);
+    assert(w.bodyCount() == bodies && w.isAlive(ids[1]) && !w.isAlive(spawned));
+    for (int i = 0; i < 20; ++i) { w.step(1.0f/60.0f); assert(same_bits(state_of(w), ahead[static_cast<std::size_t>(i)])); }
+    // The free list and generations came back too: the same create gives the same handle
+    [[maybe_unused]] const std::uint32_t respawned = w.createRigidBody(d);
+    assert(respawned == spawned);
+
+    // Ring of per-frame snapshots in caller memory: rewind 6 frames and replay
+    {
+        std::array<std::vector<std::byte>, 8> ring;
+        std::array<std::vector<Vec3>, 8> states;
+        for (int frame = 0; frame < 12; ++frame) {
+            auto& slot = ring[static_cast<std::size_t>(frame) % ring.size()];
+            slot.resize(w.snapshotSize());
+            [[maybe_unused]] const std::size_t written = w.saveSnapshot(std::span<std::byte>(slot));
+            assert(written == slot.size());
+            w.step(1.0f/60.0f);
+            states[static_cast<std::size_t>(frame) % states.size()] = state_of(w);
+        }
+        const int rewind_to = 12 - 6;
+        [[maybe_unused]] const bool rewound =
+            w.restoreSnapshot(std::span<const std::byte>(ring[static_cast<std::size_t>(rewind_to) % ring.size()]));
+        assert(rewound);
+        for (int frame = rewind_to; frame < 12; ++frame) {
+            w.step(1.0f/60.0f);
+            assert(same_bits(state_of(w), states[static_cast<std::size_t>(frame) % states.size()]));
+        }
+    }
+
+    // Rejected input leaves the world unchanged
+    {
+        const std::vector<Vec3> before = state_of(w);
+        [[maybe_unused]] const std::size_t count_before = w.bodyCount();
+        std::vector<std::byte> small(16);
+        [[maybe_unused]] const std::size_t too_small = w.saveSnapshot(std::span<std::byte>(small));
+        assert(too_small == 0);
+        WorldSnapshot bad = snap;
+        bad.bytes.resize(bad.bytes.size() - 8);
+        [[maybe_unused]] const bool truncated = w.restoreSnapshot(bad);
+        assert(!truncated);
+        bad = snap;
+        bad.bytes[0] = std::byte{0};
+        [[maybe_unused]] const bool bad_magic = w.restoreSnapshot(bad);
+        assert(!bad_magic);
+        // Well-framed blocks with inconsistent contents
+        bad = snap;
+        poke(bad, block_offset(bad, AliveList) + 8, std::uint32_t{100000000}); // body index out of range
+        [[maybe_unused]] const bool bad_index = w.restoreSnapshot(bad);
+        assert(!bad_index);
+        bad = snap;
+        poke(bad, block_offset(bad, FreeList) + 8, std::uint32_t{1}); // live slot (ids[1]) on the free list
+        [[maybe_unused]] const bool bad_free = w.restoreSnapshot(bad);
+        assert(!bad_free);
+        bad = snap;
+        poke(bad, block_offset(bad, SleepNext) + 8, std::uint32_t{5}); // free slot (ids[0]) linked into a ring
+        [[maybe_unused]] const bool bad_ring = w.restoreSnapshot(bad);
+        assert(!bad_ring);
+        bad = snap;
+        poke(bad, 16, std::uint64_t{1} << 40); // warm-start table more than half full
+        [[maybe_unused]] const bool bad_cache = w.restoreSnapshot(bad);
+        assert(!bad_cache);
+        bad = snap;
+        {
+            // Drop two velocities: a complete snapshot whose arrays disagree on the slot count
+            const std::size_t at = block_offset(bad, Vel);
+            std::uint64_t n;
+            std::memcpy(&n, bad.bytes.data() + at, sizeof(n));
+            poke(bad, at, n - 2);
+            const std::size_t from = at + 8 + ((static_cast<std::size_t>(n - 2) * 12 + 7) & ~std::size_t{7});
+            const std::size_t to = at + 8 + ((static_cast<std::size_t>(n) * 12 + 7) & ~std::size_t{7});
+            bad.bytes.erase(bad.bytes.begin() + static_cast<std::ptrdiff_t>(from), bad.bytes.begin() + static_cast<std::ptrdiff_t>(to));
+            poke(bad, 24, static_cast<std::uint64_t>(bad.bytes.size()));
+        }
+        [[maybe_unused]] const bool short_array = w.restoreSnapshot(bad);
+        assert(!short_array);
+        World other(WorldDesc{20});
+        [[maybe_unused]] const bool other_layout = other.restoreSnapshot(snap); // different handle layout
+        assert(!other_layout);
+        assert(same_bits(state_of(w), before) && w.bodyCount() == count_before);
+    }
+
+    // Restoring into a fresh world with the same layout reproduces the run
+    {
+        World copy;
+        copy.setGravity({0, -2, 0});
+        [[maybe_unused]] const bool copied = copy.restoreSnapshot(snap);
+        [[maybe_unused]] const bool reset = w.restoreSnapshot(snap);
+        assert(copied && reset);
+        for (int i = 0; i < 10; ++i) { w.step(1.0f/60.0f); copy.step(1.0f/60.0f); }
+        assert(same_bits(state_of(w), state_of(copy)));
+        // Same state, same bytes (no indeterminate padding in the warm-start table)
+        WorldSnapshot sw, sc;
+        w.saveSnapshot(sw);
+        copy.saveSnapshot(sc);
+        assert(sw.bytes == sc.bytes);
+    }
+    return 0;
+}
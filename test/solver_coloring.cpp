@@ -0,0 +1,84 @@
+#include "ape/ape.h"
+#include "ape/contact_coloring.h"
+#include "ape/job.h"
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+static std::vector<std::uint32_t> build_pile(ape::World& w) {
+    std::vector<std::uint32_t> ids;
+    ape::RigidBodyDesc d{};
+    d.sphere_radius = 0.5f;
+    d.mass = 0.0f; // floor row (infinite mass)
+    for (int i = 0; i < 30; ++i) {
+        d.position = {static_cast<float>(i), -1.0f, 0.0f};
+        ids.push_back(w.createRigidBody(d));
+    }
+    d.mass = 1.0f;
+    for (int i = 0; i < 900; ++i) {
+        d.position = {0.9f * static_cast<float>(i % 30), 0.9f * static_cast<float>(i / 30), 0.2f * static_cast<float>(i % 3)};
+        ids.push_back(w.createRigidBody(d));
+    }
+    return ids;
+}
+
+int main(){
+    using namespace ape;
+    // Coloring: star around body 0, chain 1-2-3, all on the static body 4
+    {
+        const float mass[5] = {1,1,1,1,0};
+        std::vector<Contact> contacts = {
+            {0,1, 1,0,0, 0.1f, 0.5f, 0.0f},
+            {0,2, 1,0,0, 0.1f, 0.5f, 0.0f},
+            {0,3, 1,0,0, 0.1f, 0.5f, 0.0f},
+            {1,2, 1,0,0, 0.1f, 0.5f, 0.0f},
+            {2,3, 1,0,0, 0.1f, 0.5f, 0.0f},
+            {1,4, 0,1,0, 0.1f, 0.5f, 0.0f},
+            {3,4, 0,1,0, 0.1f, 0.5f, 0.0f},
+        };
+        const std::uint32_t order[7] = {0,1,2,3,4,5,6};
+        ContactColoring cc;
+        cc.build(5, mass, contacts.data(), order, 7);
+        std::vector<int> seen(contacts.size(), 0);
+        for (std::size_t k = 0; k < cc.batchCount(); ++k) {
+            assert(cc.independent(k));
+            std::vector<int> uses(5, 0);
+            for (std::uint32_t i : cc.batch(k)) {
+                ++seen[i];
+                ++uses[contacts[i].a];
+                ++uses[contacts[i].b];
+            }
+            for (int b = 0; b < 4; ++b) assert(uses[b] <= 1); // dynamic bodies at most once per batch
+        }
+        for ([[maybe_unused]] int s : seen) assert(s == 1);
+        // Star of three needs three colors; contacts on the static body share them
+        assert(cc.batchCount() == 3);
+        assert(cc.batch(0).size() == 2 && cc.batch(0)[0] == 0 && cc.batch(0)[1] == 4);
+        assert(cc.batch(1).size() == 3 && cc.batch(1)[1] == 5 && cc.batch(1)[2] == 6);
+    }
+
+    // World: the colored solver gives identical results for any thread count
+    World serial;
+    World threaded;
+    serial.setSolver(SolverType::GraphColored);
+    threaded.setSolver(SolverType::GraphColored);
+    threaded.setThreadCount(4);
+    assert(serial.solver() == SolverType::GraphColored);
+    auto ids_s = build_pile(serial);
+    auto ids_t = build_pile(threaded);
+    for (int i = 0; i < 30; ++i) {
+        serial.step(1.0f/120.0f);
+        threaded.step(1.0f/120.0f);
+    }
+    for (std::size_t i = 0; i < ids_s.size(); ++i) {
+        [[maybe_unused]] const Vec3 ps = serial.getPosition(ids_s[i]);
+        [[maybe_unused]] const Vec3 pt = threaded.getPosition(ids_t[i]);
+        assert(std::isfinite(ps.x) && std::isfinite(ps.y) && std::isfinite(ps.z));
+        assert(ps.x == pt.x && ps.y == pt.y && ps.z == pt.z);
+        [[maybe_unused]] const Vec3 vs = serial.getVelocity(ids_s[i]);
+        [[maybe_unused]] const Vec3 vt = threaded.getVelocity(ids_t[i]);
+        assert(vs.x == vt.x && vs.y == vt.y && vs.z == vt.z);
+    }
+    return 0;
+}
@@ -0,0 +1,81 @@
+#include "ape/ape.h"
+#include "ape/contact_rows.h"
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+static std::vector<std::uint32_t> build_pile(ape::World& w) {
+    std::vector<std::uint32_t> ids;
+    ape::RigidBodyDesc d{};
+    d.sphere_radius = 0.5f;
+    d.restitution = 0.2f;
+    for (int i = 0; i < 600; ++i) {
+        d.position = {0.9f * static_cast<float>(i % 20), 0.9f * static_cast<float>(i / 20), 0.25f * static_cast<float>(i % 3)};
+        ids.push_back(w.createRigidBody(d));
+    }
+    return ids;
+}
+
+int main(){
+    using namespace ape;
+    [[maybe_unused]] const std::size_t lanes = ContactRows::laneWidth();
+    assert(lanes == 1 || lanes == 4 || lanes == 8);
+
+    // Overlapping pair is pushed apart (as in solver_velocity)
+    {
+        World w;
+        w.setSolver(SolverType::Simd);
+        RigidBodyDesc a{}; a.position = {0,0,0};
+        RigidBodyDesc b{}; b.position = {0.6f,0,0};
+        [[maybe_unused]] auto ida = w.createRigidBody(a);
+        [[maybe_unused]] auto idb = w.createRigidBody(b);
+        for (int i = 0; i < 10; ++i) w.step(1.0f/60.0f);
+        assert(w.getVelocity(idb).x - w.getVelocity(ida).x >= -1e-4f);
+    }
+
+    // Head-on collision: both solvers separate the pair the same way
+    {
+        [[maybe_unused]] float vx[2][2];
+        for (int m = 0; m < 2; ++m) {
+            World w;
+            w.setGravity({0, 0, 0});
+            w.setSolver(m == 0 ? SolverType::Sequential : SolverType::Simd);
+            RigidBodyDesc d{}; d.restitution = 0.5f;
+            d.position = {0,0,0}; d.velocity = {1,0,0};
+            auto ida = w.createRigidBody(d);
+            d.position = {1.5f,0,0}; d.velocity = {-1,0,0};
+            auto idb = w.createRigidBody(d);
+            for (int i = 0; i < 60; ++i) w.step(1.0f/120.0f);
+            vx[m][0] = w.getVelocity(ida).x;
+            vx[m][1] = w.getVelocity(idb).x;
+            assert(w.getPosition(idb).x - w.getPosition(ida).x > 0.9f);
+        }
+        assert(std::fabs(vx[0][0] - vx[1][0]) < 1e-5f && std::fabs(vx[0][1] - vx[1][1]) < 1e-5f);
+    }
+
+    // Same pile: SIMD rows track the scalar colored solver, and threads do not change results
+    World scalar;
+    World simd;
+    World simd_mt;
+    scalar.setSolver(SolverType::GraphColored);
+    simd.setSolver(SolverType::Simd);
+    simd_mt.setSolver(SolverType::Simd);
+    simd_mt.setThreadCount(4);
+    auto ids_s = build_pile(scalar);
+    auto ids_v = build_pile(simd);
+    auto ids_m = build_pile(simd_mt);
+    for (int i = 0; i < 5; ++i) {
+        scalar.step(1.0f/120.0f);
+        simd.step(1.0f/120.0f);
+        simd_mt.step(1.0f/120.0f);
+    }
+    for (std::size_t i = 0; i < ids_s.size(); ++i) {
+        [[maybe_unused]] const Vec3 ps = scalar.getPosition(ids_s[i]);
+        [[maybe_unused]] const Vec3 pv = simd.getPosition(ids_v[i]);
+        [[maybe_unused]] const Vec3 pm = simd_mt.getPosition(ids_m[i]);
+        assert(std::fabs(ps.x - pv.x) < 1e-3f && std::fabs(ps.y - pv.y) < 1e-3f && std::fabs(ps.z - pv.z) < 1e-3f);
+        assert(pv.x == pm.x && pv.y == pm.y && pv.z == pm.z);
+    }
+    return 0;
+}
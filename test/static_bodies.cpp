@@ -0,0 +1,121 @@
+#include "ape/ape.h"
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+using namespace ape;
+
+// Floor of touching static box tiles with a few spheres dropped on it
+static std::vector<std::uint32_t> build(World& w, std::vector<std::uint32_t>& tiles) {
+    RigidBodyDesc tile{};
+    tile.mass = 0.0f;
+    tile.shape_type = ShapeType::Box;
+    tile.box_half_extents = {0.5f, 0.5f, 0.5f};
+    tile.velocity = {3, 0, 0}; // ignored for static bodies
+    for (int x = 0; x < 40; ++x) {
+        for (int z = 0; z < 40; ++z) {
+            tile.position = {static_cast<float>(x), -0.5f, static_cast<float>(z)};
+            tiles.push_back(w.createRigidBody(tile));
+        }
+    }
+    std::vector<std::uint32_t> balls;
+    RigidBodyDesc d{};
+    for (int i = 0; i < 8; ++i) {
+        d.position = {4.0f + 3.0f * static_cast<float>(i), 2.0f + 0.5f * static_cast<float>(i), 10.3f};
+        balls.push_back(w.createRigidBody(d));
+    }
+    return balls;
+}
+
+int main(){
+    // Static bodies stay put, are never awake and are not tested against each other
+    {
+        World w;
+        std::vector<std::uint32_t> tiles;
+        const auto balls = build(w, tiles);
+        assert(w.isStatic(tiles[0]) && !w.isStatic(balls[0]));
+        w.step(1.0f/60.0f);
+        assert(w.debug_broadphasePairCount() == 0); // 1600 touching tiles, no pairs
+        [[maybe_unused]] const Vec3 t = w.getPosition(tiles[5]);
+        [[maybe_unused]] const Vec3 v = w.getVelocity(tiles[5]);
+        assert(t.x == 0.0f && t.y == -0.5f && t.z == 5.0f);
+        assert(v.x == 0.0f && v.y == 0.0f && v.z == 0.0f);
+        assert(!w.bodies().awake[w.slotOf(tiles[5])]);
+        if (World::statsEnabled()) assert(w.stepStats().awake_bodies == 8);
+
+        // The spheres land on the floor and fall asleep there
+        for (int i = 0; i < 300; ++i) w.step(1.0f/60.0f);
+        for (auto id : balls) {
+            [[maybe_unused]] const Vec3 p = w.getPosition(id);
+            assert(std::fabs(p.y - 0.5f) < 0.02f);
+            assert(!w.bodies().awake[w.slotOf(id)]);
+        }
+        [[maybe_unused]] const Vec3 t2 = w.getPosition(tiles[5]);
+        assert(t2.x == t.x && t2.y == t.y && t2.z == t.z);
+        assert(w.debug_broadphasePairCount() == 0); // sleeping spheres are not tested against the tiles
+
+        // setVelocity is ignored, setPosition moves the static proxy
+        w.setVelocity(tiles[5], {0, 10, 0});
+        assert(w.getVelocity(tiles[5]).y == 0.0f);
+        // Lower the 3x3 tiles around the first sphere by 2 m: it drops onto them
+        const Vec3 p0 = w.getPosition(balls[0]);
+        const long bx = std::lround(p0.x), bz = std::lround(p0.z);
+        for (long x = bx - 1; x <= bx + 1; ++x) {
+            for (long z = bz - 1; z <= bz + 1; ++z) {
+                w.setPosition(tiles[static_cast<std::size_t>(x * 40 + z)], {static_cast<float>(x), -2.5f, static_cast<float>(z)});
+            }
+        }
+        assert(w.bodies().awake[w.slotOf(balls[0])]); // moving its support woke it
+        assert(!w.bodies().awake[w.slotOf(balls[1])]);
+        for (int i = 0; i < 120; ++i) w.step(1.0f/60.0f);
+        assert(std::fabs(w.getPosition(balls[0]).y + 1.5f) < 0.02f);
+        assert(std::fabs(w.getPosition(balls[1]).y - 0.5f) < 0.02f);
+
+        // Destroying the floor wakes the spheres asleep on it and they fall
+        for (int i = 0; i < 300; ++i) w.step(1.0f/60.0f);
+        for ([[maybe_unused]] auto id : balls) assert(!w.bodies().awake[w.slotOf(id)]);
+        for (auto id : tiles) w.destroyRigidBody(id);
+        for (int i = 0; i < 30; ++i) w.step(1.0f/60.0f);
+        for ([[maybe_unused]] auto id : balls) assert(w.getPosition(id).y < 0.0f);
+        assert(w.debug_broadphasePairCount() == 0);
+    }
+
+    // Results do not depend on the broadphase backend or the thread count, and
+    // a restored snapshot rebuilds the static tree
+    auto run = [](BroadphaseType type, unsigned threads, bool via_snapshot) {
+        World w;
+        w.setBroadphase(type);
+        w.setThreadCount(threads);
+        std::vector<std::uint32_t> tiles;
+        const auto balls = build(w, tiles);
+        for (int i = 0; i < 40; ++i) w.step(1.0f/60.0f);
+        if (via_snapshot) {
+            WorldSnapshot snap;
+            w.saveSnapshot(snap);
+            World copy;
+            copy.setBroadphase(type);
+            [[maybe_unused]] const bool restored = copy.restoreSnapshot(snap);
+            assert(restored && copy.isStatic(tiles[0]));
+            for (int i = 0; i < 40; ++i) copy.step(1.0f/60.0f);
+            std::vector<Vec3> out;
+            for (auto id : balls) out.push_back(copy.getPosition(id));
+            return out;
+        }
+        for (int i = 0; i < 40; ++i) w.step(1.0f/60.0f);
+        std::vector<Vec3> out;
+        for (auto id : balls) out.push_back(w.getPosition(id));
+        return out;
+    };
+    const auto ref = run(BroadphaseType::SweepAndPrune, 1, false);
+    const std::vector<std::vector<Vec3>> others = {
+        run(BroadphaseType::DynamicTree, 1, false), run(BroadphaseType::SpatialGrid, 1, false),
+        run(BroadphaseType::Regions, 4, false), run(BroadphaseType::SweepAndPrune, 4, false),
+        run(BroadphaseType::SweepAndPrune, 1, true)};
+    for ([[maybe_unused]] const auto& o : others) {
+        for (std::size_t i = 0; i < ref.size(); ++i) {
+            assert(o[i].x == ref[i].x && o[i].y == ref[i].y && o[i].z == ref[i].z);
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,90 @@
+#include "ape/ape.h"
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+// Every heap allocation of the process (worker threads included) is counted
+static std::atomic<std::uint64_t> g_allocations{0};
+
+static void* counted_alloc(std::size_t n) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    if (void* p = std::malloc(n ? n : 1)) return p;
+    throw std::bad_alloc();
+}
+static void* counted_alloc_aligned(std::size_t n, std::align_val_t al) {
+    g_allocations.fetch_add(1, std::memory_order_relaxed);
+    const std::size_t a = static_cast<std::size_t>(al);
+#if defined(_WIN32)
+    if (void* p = _aligned_malloc(n ? n : 1, a)) return p;
+#else
+    const std::size_t size = n ? (n + a - 1) / a * a : a; // aligned_alloc wants a multiple of the alignment
+    if (void* p = std::aligned_alloc(a, size)) return p;
+#endif
+    throw std::bad_alloc();
+}
+static void free_aligned(void* p) {
+#if defined(_WIN32)
+    _aligned_free(p);
+#else
+    std::free(p);
+#endif
+}
+
+void* operator new(std::size_t n) { return counted_alloc(n); }
+void* operator new[](std::size_t n) { return counted_alloc(n); }
+void* operator new(std::size_t n, std::align_val_t al) { return counted_alloc_aligned(n, al); }
+void* operator new[](std::size_t n, std::align_val_t al) { return counted_alloc_aligned(n, al); }
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { free_aligned(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { free_aligned(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { free_aligned(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { free_aligned(p); }
+
+int main(){
+    using namespace ape;
+    const float dt = 1.0f / 60.0f;
+
+    // A falling block of overlapping spheres and boxes that stays awake: the
+    // pair and contact counts keep changing a little from step to step. After
+    // warm-up, stepping must not touch the heap for any backend or thread count.
+    for (int bp = 0; bp < 4; ++bp) {
+        for (int sv = 0; sv < 3; ++sv) {
+            for (unsigned threads : {1u, 4u}) {
+                World w;
+                w.setThreadCount(threads);
+                w.setBroadphase(static_cast<BroadphaseType>(bp));
+                w.setSolver(static_cast<SolverType>(sv));
+                w.setGravity({0, -2, 0});
+                RigidBodyDesc d{};
+                for (int i = 0; i < 500; ++i) {
+                    d.shape_type = (i % 3 == 0) ? ShapeType::Box : ShapeType::Sphere;
+                    d.position = {0.95f * static_cast<float>(i % 10), 0.95f * static_cast<float>(i / 100),
+                                  0.95f * static_cast<float>((i / 10) % 10)};
+                    d.velocity = {0.1f * static_cast<float>(i % 7) - 0.3f, 0, 0};
+                    w.createRigidBody(d);
+                }
+                for (int s = 0; s < 120; ++s) w.step(dt);
+
+                const std::uint64_t before = g_allocations.load();
+                for (int s = 0; s < 60; ++s) w.step(dt);
+                const std::uint64_t made = g_allocations.load() - before;
+                if (made != 0) {
+                    std::fprintf(stderr, "broadphase %d solver %d threads %u: %llu allocations in 60 steps\n",
+                                bp, sv, threads, static_cast<unsigned long long>(made));
+                }
+                assert(made == 0);
+                if (World::statsEnabled()) {
+                    assert(w.stepStats().buffer_growth_bytes == 0);
+                    assert(w.stepStats().contacts > 0 && w.stepStats().awake_bodies == 500);
+                }
+            }
+        }
+    }
+    return 0;
+}
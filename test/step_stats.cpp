@@ -0,0 +1,55 @@
+#include "ape/ape.h"
+#include <cassert>
+#include <cstdint>
+
+int main(){
+    using namespace ape;
+
+    World w;
+    // Zero-initialized before the first step
+    assert(w.stepStats().bodies == 0 && w.stepStats().total_ms == 0.0);
+
+    // A row of slightly overlapping spheres that comes to rest and falls asleep
+    w.setGravity({0, 0, 0});
+    RigidBodyDesc d{};
+    for (int i = 0; i < 32; ++i) {
+        d.position = {0.9f * static_cast<float>(i), 0, 0};
+        w.createRigidBody(d);
+    }
+    d.position = {0, 50, 0};
+    d.velocity = {1, 0, 0};
+    w.createRigidBody(d); // far away, no contacts
+
+    w.step(1.0f/60.0f);
+    const StepStats& s = w.stepStats();
+    if (!World::statsEnabled()) {
+        assert(s.bodies == 0 && s.contacts == 0 && s.total_ms == 0.0);
+        return 0;
+    }
+    assert(s.bodies == 33 && s.awake_bodies == 33);
+    assert(s.pairs >= 31 && s.contacts == 31);
+    assert(s.islands >= 1 && s.solved_islands >= 1);
+    assert(s.solver_iterations > 0 && s.solver_residual >= 0.0f);
+    assert(s.warm_start_hits == 0 && s.warm_start_hit_rate == 0.0f);
+    assert(s.buffer_growth_bytes > 0); // first step sizes the buffers
+    assert(s.integrate_ms >= 0.0 && s.broadphase_ms >= 0.0 && s.narrowphase_ms >= 0.0);
+    assert(s.islands_ms >= 0.0 && s.solver_ms >= 0.0 && s.sleep_ms >= 0.0);
+    [[maybe_unused]] const double stages = s.integrate_ms + s.broadphase_ms + s.narrowphase_ms + s.islands_ms + s.solver_ms + s.sleep_ms;
+    assert(s.total_ms >= stages * 0.999);
+
+    // Persisting contacts are found in the warm-start cache
+    w.step(1.0f/60.0f);
+    assert(w.stepStats().contacts > 0);
+    assert(w.stepStats().warm_start_hits == w.stepStats().contacts);
+    assert(w.stepStats().warm_start_hit_rate == 1.0f);
+
+    assert(w.stepStats().buffer_growth_bytes == 0);
+
+    // Asleep: the row's pairs are no longer formed and no island is solved
+    for (int i = 0; i < 120; ++i) w.step(1.0f/60.0f);
+    assert(w.stepStats().awake_bodies == 1); // the row fell asleep, the mover did not
+    assert(w.stepStats().pairs == 0 && w.stepStats().contacts == 0);
+    assert(w.stepStats().solved_islands == 0 && w.stepStats().solver_iterations == 0);
+    assert(w.stepStats().buffer_growth_bytes == 0);
+    return 0;
+}
@@ -0,0 +1,69 @@
+// Headless check of the web engine surface: bulk creation, stepping in native
+// code and typed-array state views.
+// Usage: node test/wasm_node.mjs [path/to/ape_wasm*.js] [threads]
+// Without a module path the JS fallback is exercised.
+import assert from 'node:assert/strict';
+import { pathToFileURL } from 'node:url';
+import { resolve } from 'node:path';
+import { createEngine } from '../web/js/engine.js';
+
+const [modulePath, threadArg] = process.argv.slice(2);
+const options = modulePath
+  ? { module: pathToFileURL(resolve(modulePath)).href, requireWasm: true, threads: Number(threadArg || 1) }
+  : {};
+const engine = await createEngine(options);
+if (modulePath) assert.notEqual(engine.kind, 'js');
+
+const world = new engine.World({ threads: options.threads });
+
+// Well separated grid so no body touches another: pure ballistic motion
+const n = 4096;
+const descs = [];
+for (let i = 0; i < n; ++i) {
+  descs.push({ position: { x: 4 * (i % 64), y: 100, z: 4 * Math.floor(i / 64) }, velocity: { x: 1, y: 0, z: 0 }, mass: 1, radius: 0.5 });
+}
+const ids = world.createRigidBodies(descs);
+assert.equal(ids.length, n);
+assert.equal(world.bodyCount, n);
+
+world.step(1 / 120, 60);
+
+const pos = world.positions();
+const alive = world.alive();
+assert.ok(alive.length >= n && pos.length === alive.length * 3);
+for (let i = 0; i < n; ++i) {
+  const s = world.slotOf(ids[i]);
+  assert.equal(alive[s], 1);
+  const x = pos[s * 3], y = pos[s * 3 + 1];
+  assert.ok(Math.abs(x - (4 * (i % 64) + 0.5)) < 1e-3, `x of body ${i}: ${x}`);
+  assert.ok(y < 100 && y > 98, `y of body ${i}: ${y}`);
+  assert.deepEqual(world.getPosition(ids[i]), { x: pos[s * 3], y: pos[s * 3 + 1], z: pos[s * 3 + 2] });
+}
+
+// Enough bodies to grow the heap past its initial size: views fetched after
+// the growth see the new memory and the earlier bodies are intact
+const more = [];
+for (let i = 0; i < 200000; ++i) {
+  more.push({ position: { x: 4 * (i % 500), y: -1000, z: 1000 + 4 * Math.floor(i / 500) }, radius: 0.5 });
+}
+const moreIds = world.createRigidBodies(more);
+assert.equal(world.bodyCount, n + more.length);
+const grown = world.positions();
+assert.ok(grown.length >= (n + more.length) * 3);
+const last = world.slotOf(moreIds[more.length - 1]);
+assert.equal(grown[last * 3 + 1], -1000);
+for (let i = 0; i < n; i += 97) {
+  const s = world.slotOf(ids[i]);
+  assert.ok(Math.abs(grown[s * 3] - (4 * (i % 64) + 0.5)) < 1e-3);
+}
+
+// clear() drops every body and keeps the gravity setting
+world.setGravity({ x: 0, y: 0, z: 0 });
+world.clear();
+assert.equal(world.bodyCount, 0);
+const [id] = world.createRigidBodies([{ position: { x: 0, y: 0, z: 0 } }]);
+world.step(1 / 60, 10);
+assert.equal(world.getPosition(id).y, 0);
+world.destroy();
+
+console.log(`wasm_node: ${engine.kind} ok`);
@@ -2,14 +2,16 @@ import { createEngine } from '../engine.js';
 
 const cfg = { running: true };
 
-function draw(ctx, bodies){
+function draw(ctx, world, radius){
   ctx.clearRect(0,0,ctx.canvas.width,ctx.canvas.height);
   ctx.save();
   ctx.fillStyle = '#a6e22e';
-  for (const b of bodies){
-    const x = (b.position.x*50)+ctx.canvas.width*0.5;
-    const y = ctx.canvas.height*0.6 + (b.position.y*-50);
-    const r = (b.radius||0.5)*50;
+  const pos = world.positions(), alive = world.alive();
+  for (let s=0;s<alive.length;s++){
+    if (!alive[s]) continue;
+    const x = (pos[s*3]*50)+ctx.canvas.width*0.5;
+    const y = ctx.canvas.height*0.6 + (pos[s*3+1]*-50);
+    const r = radius*50;
     ctx.beginPath(); ctx.arc(x,y,r,0,Math.PI*2); ctx.fill();
   }
   ctx.restore();
@@ -26,13 +28,14 @@ async function main(){
   const resetBtn = document.getElementById('collide-reset');
   const toggleBtn = document.getElementById('collide-toggle');
 
+  const r = 0.5;
+  let ids = [];
   function reset(){
-    world.bodies = [];
-    const r = 0.5;
-    const a = world.createRigidBody({ position:{x:-0.3,y:0,z:0}, velocity:{x:0,y:0,z:0}, mass:1, radius:r });
-    const b = world.createRigidBody({ position:{x:0.3,y:0,z:0}, velocity:{x:0,y:0,z:0}, mass:1, radius:r });
-    // annotate for renderer
-    world.bodies[a].radius = r; world.bodies[b].radius = r;
+    world.clear();
+    ids = world.createRigidBodies([
+      { position:{x:-0.3,y:0,z:0}, velocity:{x:0,y:0,z:0}, mass:1, radius:r },
+      { position:{x:0.3,y:0,z:0}, velocity:{x:0,y:0,z:0}, mass:1, radius:r },
+    ]);
   }
 
   reset();
@@ -45,14 +48,12 @@ async function main(){
     if (cfg.running){
       world.step(dt);
       // copy separation amount to UI
-      const a = world.getPosition(0), b = world.getPosition(1);
+      const a = world.getPosition(ids[0]), b = world.getPosition(ids[1]);
       const dx=b.x-a.x, dy=b.y-a.y, dz=b.z-a.z;
       const dist = Math.sqrt(dx*dx+dy*dy+dz*dz);
       if (sep) sep.textContent = dist.toFixed(3);
-      // sync positions for renderer
-      world.bodies[0].position = a; world.bodies[1].position = b;
     }
-    draw(ctx, world.bodies);
+    draw(ctx, world, r);
     requestAnimationFrame(loop);
   }
   requestAnimationFrame(loop);
@@ -4,13 +4,15 @@ const cfg = { running: true };
 
 function rand(min,max){ return Math.random()*(max-min)+min }
 
-function draw(ctx, bodies){
+function draw(ctx, world){
   ctx.clearRect(0,0,ctx.canvas.width,ctx.canvas.height);
   ctx.save();
   ctx.fillStyle = '#66d9ef';
-  for (const b of bodies){
-    const x = (b.position.x*10)+ctx.canvas.width*0.5;
-    const y = ctx.canvas.height*0.2 + (b.position.y*-10);
+  const pos = world.positions(), alive = world.alive();
+  for (let s=0;s<alive.length;s++){
+    if (!alive[s]) continue;
+    const x = (pos[s*3]*10)+ctx.canvas.width*0.5;
+    const y = ctx.canvas.height*0.2 + (pos[s*3+1]*-10);
     ctx.beginPath(); ctx.arc(x,y,2,0,Math.PI*2); ctx.fill();
   }
   ctx.restore();
@@ -29,10 +31,12 @@ async function main(){
   const toggleBtn = document.getElementById('falling-toggle');
 
   function reset(){
-    world.bodies = [];
+    world.clear();
+    const descs = [];
     for (let i=0;i<Number(countSlider.value);i++){
-      world.createRigidBody({ position:{x:rand(-5,5), y:rand(2,20), z:0}, velocity:{x:0,y:0,z:0}, mass:1 });
+      descs.push({ position:{x:rand(-5,5), y:rand(2,20), z:0}, velocity:{x:0,y:0,z:0}, mass:1 });
     }
+    world.createRigidBodies(descs);
   }
 
   reset();
@@ -49,10 +53,10 @@ async function main(){
     const dt = Math.min(1/60, (t-last)/1000); last = t;
     if (cfg.running){
       // fixed 120 Hz internal for smoother motion
-      const sub = 2; const subdt = dt/sub;
-      for (let i=0;i<sub;i++) world.step(subdt);
+      const sub = 2;
+      world.step(dt/sub, sub);
     }
-    draw(ctx, world.bodies);
+    draw(ctx, world);
     requestAnimationFrame(loop);
   }
   requestAnimationFrame(loop);
@@ -3,13 +3,15 @@ import { createEngine } from '../engine.js';
 const cfg = { running: true };
 function rand(min,max){ return Math.random()*(max-min)+min }
 
-function draw(ctx, bodies){
+function draw(ctx, world){
   ctx.clearRect(0,0,ctx.canvas.width,ctx.canvas.height);
   ctx.save();
   ctx.fillStyle = '#c678dd';
-  for (const b of bodies){
-    const x = (b.position.x*10)+ctx.canvas.width*0.5;
-    const y = ctx.canvas.height*0.5 + (b.position.y*-10);
+  const pos = world.positions(), alive = world.alive();
+  for (let s=0;s<alive.length;s++){
+    if (!alive[s]) continue;
+    const x = (pos[s*3]*10)+ctx.canvas.width*0.5;
+    const y = ctx.canvas.height*0.5 + (pos[s*3+1]*-10);
     ctx.fillRect(x-1,y-1,2,2);
   }
   ctx.restore();
@@ -30,22 +32,24 @@ async function main(){
   const toggleBtn = document.getElementById('gp-toggle');
 
   function spawn(n){
-    for (let i=0;i<n;i++) world.createRigidBody({ position:{x:rand(-5,5), y:rand(-1,5), z:rand(-5,5)}, velocity:{x:0,y:0,z:0}, mass:1 });
+    const descs = [];
+    for (let i=0;i<n;i++) descs.push({ position:{x:rand(-5,5), y:rand(-1,5), z:rand(-5,5)}, velocity:{x:0,y:0,z:0}, mass:1 });
+    world.createRigidBodies(descs);
   }
 
   function updateG(){ world.setGravity({x:Number(gx.value), y:Number(gy.value), z:Number(gz.value)}); }
   updateG();
 
   spawnBtn.addEventListener('click', ()=>spawn(100));
-  clearBtn.addEventListener('click', ()=>{ world.bodies = []; });
+  clearBtn.addEventListener('click', ()=>{ world.clear(); });
   toggleBtn.addEventListener('click', ()=>{ cfg.running = !cfg.running; toggleBtn.textContent = cfg.running ? 'Pause' : 'Resume'; });
   gx.addEventListener('input', updateG); gy.addEventListener('input', updateG); gz.addEventListener('input', updateG);
 
   let last = performance.now();
   function loop(t){
     const dt = Math.min(1/60, (t-last)/1000); last = t;
-    if (cfg.running){ const sub = 2; const subdt = dt/sub; for (let i=0;i<sub;i++) world.step(subdt); }
-    draw(ctx, world.bodies);
+    if (cfg.running){ const sub = 2; world.step(dt/sub, sub); }
+    draw(ctx, world);
     requestAnimationFrame(loop);
   }
   requestAnimationFrame(loop);
@@ -2,14 +2,16 @@ import { createEngine } from '../engine.js';
 
 const cfg = { running: true };
 
-function draw(ctx, bodies) {
+function draw(ctx, world, radius) {
     ctx.clearRect(0, 0, ctx.canvas.width, ctx.canvas.height);
     ctx.save();
     ctx.fillStyle = '#f92672';
-    for (const b of bodies) {
-        const x = (b.position.x * 50) + ctx.canvas.width * 0.5;
-        const y = ctx.canvas.height - (b.position.y * 50);
-        const r = (b.radius || 0.5) * 50;
+    const pos = world.positions(), alive = world.alive();
+    for (let s = 0; s < alive.length; s++) {
+        if (!alive[s]) continue;
+        const x = (pos[s * 3] * 50) + ctx.canvas.width * 0.5;
+        const y = ctx.canvas.height - (pos[s * 3 + 1] * 50);
+        const r = radius * 50;
         ctx.beginPath(); ctx.arc(x, y, r, 0, Math.PI * 2); ctx.fill();
     }
     ctx.restore();
@@ -28,18 +30,19 @@ async function main() {
     const toggleBtn = document.getElementById('stack-toggle');
 
     function reset() {
-        world.bodies = [];
+        world.clear();
         const fric = Number(frictionSlider.value);
         const rest = Number(restitutionSlider.value);
         // Create stack of spheres
+        const descs = [];
         for (let i = 0; i < 5; i++) {
-            const id = world.createRigidBody({
+            descs.push({
                 position: { x: 0, y: 0.5 + i * 1.0, z: 0 },
                 velocity: { x: 0, y: 0, z: 0 },
                 mass: 1, radius: 0.5, friction: fric, restitution: rest
             });
-            world.bodies[id] = { position: { x: 0, y: 0.5 + i * 1.0, z: 0 }, radius: 0.5 };
         }
+        world.createRigidBodies(descs);
     }
 
     reset();
@@ -49,14 +52,8 @@ async function main() {
     let last = performance.now();
     function loop(t) {
         const dt = Math.min(1 / 60, (t - last) / 1000); last = t;
-        if (cfg.running) {
-            world.step(dt);
-            // Sync positions from world to renderer
-            for (let i = 0; i < world.bodies.length; i++) {
-                world.bodies[i].position = world.getPosition(i);
-            }
-        }
-        draw(ctx, world.bodies);
+        if (cfg.running) world.step(dt);
+        draw(ctx, world, 0.5);
         requestAnimationFrame(loop);
     }
     requestAnimationFrame(loop);
@@ -1,102 +1,209 @@
-// Minimal engine loader for demos. In the future, load WASM build of APE.
-// For now, provide a deterministic JS fallback with the same surface we need.
+// Engine loader for demos and headless tests. Prefers the threaded WASM build
+// (ape_wasm_mt: wasm-simd128 + pthreads, needs SharedArrayBuffer / cross-origin
+// isolation), then the single-threaded ape_wasm, then a deterministic JS fallback.
+//
+// Every backend exposes the same World surface. Body state is read through
+// typed-array views indexed by slot (positions(): x,y,z per slot; alive(): 1 per
+// occupied slot). With WASM the views alias the engine's SoA storage: no copies,
+// no per-body calls. Views are only valid until the next create/clear/step;
+// fetch them again each frame.
+
+const DESC_WORDS = 16; // ape_rigidbody_desc_ex: 64 bytes
 
 class JsWorld {
   constructor() {
-    this.bodies = [];
     this.g = { x: 0, y: -9.80665, z: 0 };
+    this.clear();
+  }
+  clear() {
+    this.count = 0;
+    this.pos = new Float32Array(0);
+    this.vel = new Float32Array(0);
+    this.live = new Uint8Array(0);
+  }
+  reserve(capacity) {
+    if (capacity <= this.live.length) return;
+    const grow = (a, n) => { const b = new a.constructor(n); b.set(a); return b; };
+    this.pos = grow(this.pos, capacity * 3);
+    this.vel = grow(this.vel, capacity * 3);
+    this.live = grow(this.live, capacity);
   }
-  createRigidBody(desc) {
-    const d = { position: { ...(desc.position || { x: 0, y: 0, z: 0 }) }, velocity: { ...(desc.velocity || { x: 0, y: 0, z: 0 }) }, mass: desc.mass ?? 1, radius: desc.radius ?? 0.5 };
-    const id = this.bodies.length;
-    this.bodies.push(d);
-    return id;
+  createRigidBodies(descs) {
+    this.reserve(Math.max(this.count + descs.length, this.live.length * 2));
+    const ids = new Uint32Array(descs.length);
+    for (let i = 0; i < descs.length; ++i) {
+      const d = descs[i], s = this.count++;
+      const p = d.position || {}, v = d.velocity || {};
+      this.pos[s * 3] = p.x || 0; this.pos[s * 3 + 1] = p.y || 0; this.pos[s * 3 + 2] = p.z || 0;
+      this.vel[s * 3] = v.x || 0; this.vel[s * 3 + 1] = v.y || 0; this.vel[s * 3 + 2] = v.z || 0;
+      this.live[s] = 1;
+      ids[i] = s;
+    }
+    return ids;
   }
-  setGravity(g) { this.g = { ...g }; }
-  getPosition(id) { const b = this.bodies[id]; return b ? { ...b.position } : { x: 0, y: 0, z: 0 }; }
-  step(dt) {
-    for (const b of this.bodies) {
-      b.velocity.x += this.g.x * dt; b.velocity.y += this.g.y * dt; b.velocity.z += this.g.z * dt;
-      b.position.x += b.velocity.x * dt; b.position.y += b.velocity.y * dt; b.position.z += b.velocity.z * dt;
+  createRigidBody(desc) { return this.createRigidBodies([desc])[0]; }
+  get bodyCount() { return this.count; }
+  setGravity(g) { this.g = { x: g.x || 0, y: g.y || 0, z: g.z || 0 }; }
+  slotOf(id) { return id < this.count ? id : 0xFFFFFFFF; }
+  positions() { return this.pos.subarray(0, this.count * 3); }
+  velocities() { return this.vel.subarray(0, this.count * 3); }
+  alive() { return this.live.subarray(0, this.count); }
+  getPosition(id) { const p = this.pos, s = id * 3; return id < this.count ? { x: p[s], y: p[s + 1], z: p[s + 2] } : { x: 0, y: 0, z: 0 }; }
+  getVelocity(id) { const v = this.vel, s = id * 3; return id < this.count ? { x: v[s], y: v[s + 1], z: v[s + 2] } : { x: 0, y: 0, z: 0 }; }
+  step(dt, n = 1) {
+    const p = this.pos, v = this.vel, g = this.g;
+    for (let k = 0; k < n; ++k) {
+      for (let s = 0; s < this.count * 3; s += 3) {
+        v[s] += g.x * dt; v[s + 1] += g.y * dt; v[s + 2] += g.z * dt;
+        p[s] += v[s] * dt; p[s + 1] += v[s + 1] * dt; p[s + 2] += v[s + 2] * dt;
+      }
     }
   }
+  destroy() { this.clear(); }
 }
 
-async function tryLoadWasm() {
-  // Convention: ape_wasm.js (Emscripten MODULARIZE=1) + ape_wasm.wasm in the same folder
-  try {
-    const modFactory = (await import('./ape_wasm.js')).default;
-    const Module = await modFactory({ locateFile: (p) => p });
-    // Minimal wrapper around C ABI via ccall/cwrap
-    const cwrap = Module.cwrap.bind(Module);
-    const _world_create = cwrap('ape_world_create', 'number', []);
-    const _world_destroy = cwrap('ape_world_destroy', null, ['number']);
-    const _world_step = cwrap('ape_world_step', null, ['number', 'number']);
-    const _world_create_rb_p = cwrap('ape_world_create_rigidbody_p', 'number', ['number', 'number']);
-    const _world_get_pos_out = cwrap('ape_world_get_position_out', null, ['number', 'number', 'number']);
-    const _world_get_vel_out = cwrap('ape_world_get_velocity_out', null, ['number', 'number', 'number']);
-    const _world_set_g_p = cwrap('ape_world_set_gravity_p', null, ['number', 'number']);
-    const sizeVec3 = 12; // 3 * float32
-    const sizeDesc = 32; // two vec3 + 2 floats (mass, radius)
-    class WasmWorld {
-      constructor() { this.ptr = _world_create(); }
-      createRigidBody(desc) {
-        const ptr = Module._malloc(sizeDesc);
-        const f32 = new Float32Array(Module.HEAPF32.buffer, ptr, sizeDesc / 4);
-        // position (0..2), velocity (3..5), mass (6 as float32 after padding); layout matches ape_rigidbody_desc
-        f32[0] = desc.position?.x || 0; f32[1] = desc.position?.y || 0; f32[2] = desc.position?.z || 0;
-        f32[3] = desc.velocity?.x || 0; f32[4] = desc.velocity?.y || 0; f32[5] = desc.velocity?.z || 0;
-        // Mass at offset 24 => index 6; radius at offset 28 => index 7
-        f32[6] = desc.mass ?? 1;
-        f32[7] = desc.radius ?? 0.5;
-        const id = _world_create_rb_p(this.ptr, ptr);
-        Module._free(ptr);
-        return id >>> 0;
-      }
-      setGravity(g) {
-        const ptr = Module._malloc(sizeVec3);
-        const f32 = new Float32Array(Module.HEAPF32.buffer, ptr, 3);
-        f32[0] = g.x || 0; f32[1] = g.y || 0; f32[2] = g.z || 0;
-        _world_set_g_p(this.ptr, ptr);
-        Module._free(ptr);
-      }
-      getPosition(id) {
-        const ptr = Module._malloc(sizeVec3);
-        _world_get_pos_out(this.ptr, id >>> 0, ptr);
-        const f32 = new Float32Array(Module.HEAPF32.buffer, ptr, 3);
-        const out = { x: f32[0], y: f32[1], z: f32[2] };
-        Module._free(ptr);
-        return out;
-      }
-      step(dt) { _world_step(this.ptr, dt); }
-      getVelocity(id) {
-        const ptr = Module._malloc(sizeVec3);
-        _world_get_vel_out(this.ptr, id >>> 0, ptr);
-        const f32 = new Float32Array(Module.HEAPF32.buffer, ptr, 3);
-        const out = { x: f32[0], y: f32[1], z: f32[2] };
-        Module._free(ptr);
-        return out;
+function wrapModule(Module, threaded) {
+  const cwrap = Module.cwrap.bind(Module);
+  const c = {
+    create: cwrap('ape_world_create', 'number', []),
+    destroy: cwrap('ape_world_destroy', null, ['number']),
+    step_n: cwrap('ape_world_step_n', null, ['number', 'number', 'number']),
+    set_threads: cwrap('ape_world_set_thread_count', null, ['number', 'number']),
+    create_bodies: cwrap('ape_world_create_rigidbodies_ex', 'number', ['number', 'number', 'number', 'number']),
+    body_count: cwrap('ape_world_body_count', 'number', ['number']),
+    slots_of: cwrap('ape_world_slots_of', null, ['number', 'number', 'number', 'number']),
+    positions_ptr: cwrap('ape_world_get_positions_ptr', 'number', ['number', 'number']),
+    velocities_ptr: cwrap('ape_world_get_velocities_ptr', 'number', ['number', 'number']),
+    alive_ptr: cwrap('ape_world_get_alive_ptr', 'number', ['number', 'number']),
+    set_gravity_p: cwrap('ape_world_set_gravity_p', null, ['number', 'number']),
+  };
+  // Current heap buffer, read again for every view. Growing the memory detaches
+  // a plain ArrayBuffer; a SharedArrayBuffer (pthreads) stays attached but keeps
+  // its old length, so views made before a grow cannot reach the new pages. The
+  // HEAP* exports are only refreshed lazily when a worker grew the memory, so
+  // prefer the memory object itself.
+  const heap = () => (Module.wasmMemory ? Module.wasmMemory.buffer : Module.HEAPU8.buffer);
+  const poolSize = 4; // -sPTHREAD_POOL_SIZE of ape_wasm_mt
+
+  class WasmWorld {
+    constructor(options = {}) {
+      // Scratch: 16 bytes for out-params (count, gravity) kept for the world's lifetime
+      this.scratch = Module._malloc(16);
+      const hw = (typeof navigator !== 'undefined' && navigator.hardwareConcurrency) || poolSize;
+      this.threads = threaded ? Math.min(options.threads ?? hw, poolSize) : 1;
+      this.g = { x: 0, y: -9.80665, z: 0 };
+      this.ptr = 0;
+      this.clear();
+    }
+    clear() {
+      if (this.ptr) c.destroy(this.ptr);
+      this.ptr = c.create();
+      if (this.threads > 1) c.set_threads(this.ptr, this.threads);
+      this.setGravity(this.g);
+    }
+    createRigidBodies(descs) {
+      const n = descs.length;
+      if (n === 0) return new Uint32Array(0);
+      // One allocation for the whole batch: descs followed by the id array
+      const base = Module._malloc(n * DESC_WORDS * 4 + n * 4);
+      const f32 = new Float32Array(heap(), base, n * DESC_WORDS);
+      const u32 = new Uint32Array(heap(), base, n * DESC_WORDS);
+      for (let i = 0; i < n; ++i) {
+        const d = descs[i], o = i * DESC_WORDS;
+        const p = d.position || {}, v = d.velocity || {}, h = d.halfExtents || {};
+        f32[o] = p.x || 0; f32[o + 1] = p.y || 0; f32[o + 2] = p.z || 0;
+        f32[o + 3] = v.x || 0; f32[o + 4] = v.y || 0; f32[o + 5] = v.z || 0;
+        f32[o + 6] = d.mass ?? 1;
+        u32[o + 7] = d.shape === 'box' ? 1 : 0;
+        f32[o + 8] = d.radius ?? 0.5;
+        f32[o + 9] = h.x ?? 0.5; f32[o + 10] = h.y ?? 0.5; f32[o + 11] = h.z ?? 0.5;
+        f32[o + 12] = d.friction ?? 0.5;
+        f32[o + 13] = d.restitution ?? 0;
+        u32[o + 14] = d.category ?? 0; // 0 = default (category 1, mask all)
+        u32[o + 15] = d.mask ?? 0;
       }
-      destroy() { if (this.ptr) { _world_destroy(this.ptr); this.ptr = 0; } }
+      const idsPtr = base + n * DESC_WORDS * 4;
+      c.create_bodies(this.ptr, base, n, idsPtr);
+      const ids = new Uint32Array(heap(), idsPtr, n).slice();
+      Module._free(base);
+      return ids;
     }
-    return {
-      World: WasmWorld,
-      version: { major: Module.ccall('ape_version_major', 'number', [], []), minor: Module.ccall('ape_version_minor', 'number', [], []), patch: Module.ccall('ape_version_patch', 'number', [], []) }
-    };
+    createRigidBody(desc) { return this.createRigidBodies([desc])[0]; }
+    get bodyCount() { return c.body_count(this.ptr) >>> 0; }
+    setGravity(g) {
+      this.g = { x: g.x || 0, y: g.y || 0, z: g.z || 0 };
+      const f32 = new Float32Array(heap(), this.scratch, 3);
+      f32[0] = this.g.x; f32[1] = this.g.y; f32[2] = this.g.z;
+      c.set_gravity_p(this.ptr, this.scratch);
+    }
+    slotOf(id) {
+      const u32 = new Uint32Array(heap(), this.scratch, 2);
+      u32[0] = id >>> 0;
+      c.slots_of(this.ptr, this.scratch, 1, this.scratch + 4);
+      return new Uint32Array(heap(), this.scratch, 2)[1];
+    }
+    view(fn, Type, per) {
+      const p = fn(this.ptr, this.scratch);
+      const n = new Uint32Array(heap(), this.scratch, 1)[0]; // size_t is 32-bit in wasm32
+      return p ? new Type(heap(), p, n * per) : new Type(0);
+    }
+    positions() { return this.view(c.positions_ptr, Float32Array, 3); }
+    velocities() { return this.view(c.velocities_ptr, Float32Array, 3); }
+    alive() { return this.view(c.alive_ptr, Uint8Array, 1); }
+    getPosition(id) {
+      const s = this.slotOf(id);
+      if (s === 0xFFFFFFFF) return { x: 0, y: 0, z: 0 };
+      const p = this.positions();
+      return { x: p[s * 3], y: p[s * 3 + 1], z: p[s * 3 + 2] };
+    }
+    getVelocity(id) {
+      const s = this.slotOf(id);
+      if (s === 0xFFFFFFFF) return { x: 0, y: 0, z: 0 };
+      const v = this.velocities();
+      return { x: v[s * 3], y: v[s * 3 + 1], z: v[s * 3 + 2] };
+    }
+    step(dt, n = 1) { c.step_n(this.ptr, dt, n); }
+    destroy() {
+      if (this.ptr) { c.destroy(this.ptr); this.ptr = 0; }
+      if (this.scratch) { Module._free(this.scratch); this.scratch = 0; }
+    }
+  }
+  const version = {
+    major: Module.ccall('ape_version_major', 'number', [], []),
+    minor: Module.ccall('ape_version_minor', 'number', [], []),
+    patch: Module.ccall('ape_version_patch', 'number', [], []),
+  };
+  return { World: WasmWorld, version, kind: threaded ? 'wasm-mt' : 'wasm' };
+}
+
+async function tryLoadWasm(url, threaded) {
+  // Convention: Emscripten MODULARIZE=1 + EXPORT_ES6=1 module with its .wasm alongside
+  try {
+    const modFactory = (await import(url)).default;
+    const Module = await modFactory();
+    return wrapModule(Module, threaded);
   } catch (e) {
     return null;
   }
 }
 
-export async function createEngine() {
-  const wasm = await tryLoadWasm();
-  if (wasm) {
-    const status = document.getElementById('engine-status');
-    if (status) status.textContent = `Engine: WASM v${wasm.version.major}.${wasm.version.minor}.${wasm.version.patch}`;
-    return wasm;
+// options.module: URL of an Emscripten module to load instead of the defaults
+// options.requireWasm: throw instead of falling back to the JS engine
+export async function createEngine(options = {}) {
+  const canThread = typeof SharedArrayBuffer !== 'undefined' && (globalThis.crossOriginIsolated ?? true);
+  let engine = null;
+  if (options.module) {
+    engine = await tryLoadWasm(options.module, /_mt\.js$/.test(options.module));
+  } else {
+    if (canThread) engine = await tryLoadWasm(new URL('./ape_wasm_mt.js', import.meta.url).href, true);
+    if (!engine) engine = await tryLoadWasm(new URL('./ape_wasm.js', import.meta.url).href, false);
+  }
+  if (!engine) {
+    if (options.requireWasm) throw new Error(`APE WASM module not available (${options.module || 'ape_wasm*.js'})`);
+    engine = { World: JsWorld, version: { major: 0, minor: 0, patch: 1 }, kind: 'js' };
   }
-  const engine = { World: JsWorld, version: { major: 0, minor: 0, patch: 1 } };
-  const status = document.getElementById('engine-status');
-  if (status) status.textContent = `Engine: JS fallback v${engine.version.major}.${engine.version.minor}.${engine.version.patch}`;
+  const label = engine.kind === 'js' ? 'JS fallback' : engine.kind === 'wasm-mt' ? 'WASM (SIMD + threads)' : 'WASM';
+  const status = typeof document !== 'undefined' ? document.getElementById('engine-status') : null;
+  if (status) status.textContent = `Engine: ${label} v${engine.version.major}.${engine.version.minor}.${engine.version.patch}`;
   return engine;
 }